@@ -0,0 +1,153 @@
+#pragma once
+
+// COOPERATIVE SCHEDULER
+// ---------------------
+// Replaces the "if (millis() - previousX > N)" polling in loop(): tasks have a
+// deadline (periodic tasks) and/or are woken up by events (ESP-NOW packet, web
+// request, button interrupt...). run() executes the tasks that are due, earliest
+// deadline first, then calls the idle hook with the time left until the next
+// deadline so the core can sleep instead of spinning loop().
+//
+//   int tick = scheduler.add("tick", onTick, 1000);    // Every second
+//   int packets = scheduler.add("packets", onPackets); // Only when woken up
+//   scheduler.wake(packets);                           // From any task (wakeFromISR() in an ISR)
+//   void loop() { scheduler.run(); }
+//
+// Only a handful of tasks exist, so the "deadline ordered" queue is a plain
+// array scanned for the earliest deadline. No allocation, wakeups are a lock-free
+// bit mask (N <= 32).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "hal.h"
+
+template <size_t N>
+class CooperativeScheduler {
+  static_assert(N > 0 && N <= 32, "CooperativeScheduler: at most 32 tasks");
+
+  public:
+    typedef void (*TaskFunction)();
+    typedef void (*IdleHook)(uint32_t maxSleepMs);
+
+    // periodMs = 0: event task, only runs when woken up. Returns the task id (-1 if full)
+    int add(const char *name, TaskFunction function, uint32_t periodMs = 0, uint32_t firstRunInMs = 0) {
+      if (count_ == N) return -1;
+      Task &task = tasks_[count_];
+      task.name = name;
+      task.function = function;
+      task.periodMs = periodMs;
+      task.armed = periodMs > 0;
+      task.deadlineMs = millis() + firstRunInMs;
+      return count_++;
+    }
+
+    // Run the task as soon as possible. Safe from other tasks (ESP-NOW callback,
+    // web server...), use wakeFromISR() from an interrupt handler
+    void wake(int id) {
+      wakeups_.fetch_or(1UL << id);
+      wakeLoop();
+    }
+    void wakeFromISR(int id) {
+      wakeups_.fetch_or(1UL << id);
+      wakeLoopFromISR();
+    }
+
+    // loop() side only: next run in delayMs (replaces the current deadline)
+    void runIn(int id, uint32_t delayMs) {
+      tasks_[id].deadlineMs = millis() + delayMs;
+      tasks_[id].armed = true;
+    }
+    // loop() side only: no deadline anymore, the task only runs when woken up
+    void park(int id) {
+      tasks_[id].armed = false;
+    }
+
+    // loop() side only: new period for a periodic task, next run one period from now (0: park it)
+    void setPeriod(int id, uint32_t periodMs) {
+      tasks_[id].periodMs = periodMs;
+      if (periodMs > 0) runIn(id, periodMs);
+      else park(id);
+    }
+
+    // Replaces idleWait() (power management: light sleep...), gets the time to the next deadline
+    void setIdleHook(IdleHook hook) { idleHook_ = hook; }
+
+    // Runs every task due (each at most once), earliest deadline first, then idles
+    void run() {
+      uint32_t woken = wakeups_.exchange(0);
+      for (size_t i = 0; i < count_; i++) tasks_[i].ranThisPass = false;
+
+      for (;;) {
+        uint32_t now = millis();
+        int next = -1;
+        int32_t nextLate = 0;
+        for (size_t i = 0; i < count_; i++) {
+          Task &task = tasks_[i];
+          if (task.ranThisPass) continue;
+          // A woken up task is due now, whatever its deadline
+          int32_t late = (woken & (1UL << i)) ? INT32_MAX : (task.armed ? (int32_t)(now - task.deadlineMs) : -1);
+          if (late < 0) continue;
+          if (next < 0 || late > nextLate) {
+            next = i;
+            nextLate = late;
+          }
+        }
+        if (next < 0) break;
+
+        Task &task = tasks_[next];
+        task.ranThisPass = true;
+        woken &= ~(1UL << next);
+        if (task.periodMs > 0) {
+          // Next deadline keeps the period (no drift), unless we are more than a period late
+          task.deadlineMs += task.periodMs;
+          if ((int32_t)(now - task.deadlineMs) >= 0) task.deadlineMs = now + task.periodMs;
+        } else {
+          task.armed = false;
+        }
+        uint32_t startedUs = micros();
+        task.function();
+        task.runs++;
+        task.busyUs += micros() - startedUs;
+      }
+
+      // Idle until the next deadline (or the next wakeup)
+      if (wakeups_.load() != 0) return;
+      uint32_t now = millis();
+      uint32_t sleepMs = UINT32_MAX;
+      for (size_t i = 0; i < count_; i++) {
+        if (!tasks_[i].armed) continue;
+        int32_t left = (int32_t)(tasks_[i].deadlineMs - now);
+        uint32_t leftMs = left > 0 ? left : 0;
+        if (leftMs < sleepMs) sleepMs = leftMs;
+      }
+      if (sleepMs > 0 && idleHook_) {
+        idleHook_(sleepMs);
+        idleCalls_++;
+      }
+    }
+
+    size_t count() const { return count_; }
+    const char *name(int id) const { return tasks_[id].name; }
+    uint32_t runs(int id) const { return tasks_[id].runs; }
+    uint64_t busyUs(int id) const { return tasks_[id].busyUs; }
+    uint32_t idleCalls() const { return idleCalls_; }
+
+  private:
+    struct Task {
+      const char *name;
+      TaskFunction function;
+      uint32_t periodMs;
+      uint32_t deadlineMs;
+      bool armed;               // Has a deadline
+      bool ranThisPass;
+      uint32_t runs = 0;
+      uint64_t busyUs = 0;
+    };
+
+    Task tasks_[N];
+    size_t count_ = 0;
+    std::atomic<uint32_t> wakeups_{0};
+    IdleHook idleHook_ = idleWait;
+    uint32_t idleCalls_ = 0;
+};
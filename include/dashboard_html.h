@@ -0,0 +1,216 @@
+#pragma once
+
+// GENERATED by tools/embed_web.py from web/index.html, do not edit.
+// 9894 bytes of HTML, 3221 bytes gzip compressed.
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal.h"
+
+#define DASHBOARD_HTML_ETAG "\"098f51a8cac4c70a\""
+
+const size_t dashboard_html_gz_len = 3221;
+const uint8_t dashboard_html_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5a, 0x7b, 0x73, 0x1b, 0xb7,
+  0x11, 0xff, 0xdf, 0x9f, 0x62, 0xc5, 0x74, 0x7c, 0xc7, 0x84, 0x3c, 0x3e, 0x94, 0x87, 0xcb, 0x57,
+  0xc6, 0x51, 0xa4, 0xa6, 0x8d, 0x24, 0x7a, 0x24, 0x25, 0x9e, 0x8e, 0x93, 0x99, 0x82, 0x77, 0x20,
+  0x89, 0xea, 0x5e, 0xc5, 0x81, 0xa4, 0x18, 0xc5, 0xdf, 0xbd, 0xbb, 0x00, 0xee, 0xc5, 0x87, 0x24,
+  0xcf, 0x24, 0x33, 0xad, 0x6c, 0x8b, 0x47, 0x60, 0xf1, 0xc3, 0xbe, 0xb0, 0xbb, 0xd8, 0xf3, 0xe8,
+  0xe4, 0xfb, 0xe9, 0xd9, 0xdd, 0x3f, 0xdf, 0x9d, 0xc3, 0x0f, 0x77, 0x57, 0x97, 0x93, 0xd1, 0x52,
+  0x45, 0xe1, 0xe4, 0xd5, 0x68, 0xc9, 0x59, 0x30, 0x79, 0x05, 0x30, 0x52, 0x42, 0x85, 0x7c, 0xf2,
+  0xdd, 0x8f, 0x53, 0xf8, 0x1b, 0x93, 0x01, 0x8f, 0xe1, 0x76, 0x9b, 0x29, 0x1e, 0x8d, 0x3a, 0x66,
+  0x82, 0x48, 0x22, 0xae, 0x18, 0xc4, 0x2c, 0xe2, 0xe3, 0xc6, 0x5a, 0xf0, 0x4d, 0x9a, 0x48, 0xd5,
+  0x00, 0x3f, 0x89, 0x15, 0x8f, 0xd5, 0xb8, 0xb1, 0x11, 0x81, 0x5a, 0x8e, 0x03, 0xbe, 0x16, 0x3e,
+  0x6f, 0xeb, 0x2f, 0x2d, 0x10, 0xb1, 0x50, 0x82, 0x85, 0xed, 0xcc, 0x67, 0x21, 0x1f, 0xf7, 0x1a,
+  0x1a, 0x26, 0x14, 0xf1, 0x3d, 0x48, 0x1e, 0x8e, 0x1b, 0x02, 0x17, 0x37, 0x60, 0x29, 0xf9, 0x7c,
+  0xdc, 0x08, 0x98, 0x62, 0x83, 0x96, 0xa1, 0xc8, 0xd4, 0xd6, 0x6c, 0x09, 0x40, 0x6c, 0xc2, 0xe3,
+  0x1c, 0x37, 0x69, 0xcf, 0x59, 0x24, 0xc2, 0xed, 0x00, 0xde, 0x4a, 0x84, 0x1c, 0x42, 0x20, 0xb2,
+  0x34, 0x64, 0xf8, 0x5d, 0xc4, 0x88, 0xc8, 0xdb, 0xb3, 0x30, 0xf1, 0xef, 0x87, 0xa0, 0xf8, 0x83,
+  0x6a, 0xb3, 0x50, 0x2c, 0xe2, 0x01, 0xf8, 0xc8, 0x18, 0x97, 0xc3, 0x8f, 0x06, 0xa9, 0x6f, 0x71,
+  0x32, 0xf1, 0x1b, 0x1f, 0x40, 0xdf, 0xeb, 0x4a, 0x1e, 0xd9, 0xb9, 0xb4, 0x36, 0x75, 0x5a, 0x9d,
+  0x9a, 0x25, 0xc1, 0x16, 0x1e, 0x23, 0xf6, 0x60, 0x64, 0x1a, 0xc0, 0xd7, 0xdd, 0x6e, 0xfa, 0x30,
+  0x84, 0x88, 0xc9, 0x85, 0x88, 0x07, 0xf8, 0x0c, 0x6c, 0xa5, 0x92, 0x21, 0xa4, 0x2c, 0x08, 0x44,
+  0xbc, 0x68, 0xcf, 0x12, 0xa5, 0x92, 0x08, 0x37, 0xf8, 0x0a, 0xc9, 0x0c, 0x86, 0x62, 0xb3, 0x90,
+  0xc3, 0xe3, 0x2c, 0x41, 0xc5, 0xca, 0xb6, 0x9f, 0x84, 0x21, 0x4b, 0x33, 0xdc, 0x28, 0x7f, 0x1a,
+  0x1a, 0xb0, 0x76, 0xc8, 0xe7, 0x6a, 0xa0, 0xd1, 0xec, 0x80, 0x14, 0x8b, 0xa5, 0x1d, 0xb1, 0x48,
+  0x41, 0x0b, 0xd4, 0x32, 0x87, 0x1a, 0x40, 0x0f, 0xb7, 0xcf, 0x92, 0x50, 0x04, 0xf0, 0x59, 0xa0,
+  0x7f, 0xea, 0x0a, 0x20, 0xc0, 0x82, 0xb3, 0x01, 0xbc, 0x29, 0x39, 0x92, 0x83, 0x58, 0x2d, 0xdb,
+  0xfe, 0x52, 0x84, 0x81, 0xcb, 0xd7, 0x3c, 0x6e, 0xc2, 0x23, 0xcc, 0x98, 0x7f, 0xbf, 0x90, 0xc9,
+  0x2a, 0x0e, 0x88, 0xc7, 0x04, 0xe1, 0x0b, 0x50, 0x5a, 0x35, 0xea, 0x58, 0xbb, 0x8c, 0x3a, 0xc6,
+  0x6b, 0x46, 0xa4, 0x1b, 0x6d, 0xb0, 0x65, 0xff, 0x90, 0xe7, 0xe0, 0x28, 0x4e, 0x4e, 0x53, 0x2e,
+  0x99, 0xc2, 0xfd, 0xe1, 0x2a, 0x09, 0x50, 0xe8, 0x51, 0x96, 0xb2, 0x18, 0x44, 0x30, 0x76, 0x92,
+  0x34, 0x8b, 0x70, 0xc8, 0x99, 0x20, 0x32, 0x8e, 0x4d, 0x46, 0x33, 0xd9, 0xd1, 0x70, 0xcc, 0xf8,
+  0x84, 0xd3, 0x89, 0x18, 0x22, 0x49, 0x22, 0xfa, 0x96, 0x7e, 0x8d, 0x93, 0xd8, 0x99, 0x5c, 0x24,
+  0xd2, 0xe7, 0x30, 0xbd, 0x1e, 0x75, 0xd8, 0x33, 0xc4, 0xf3, 0x79, 0x41, 0x7d, 0x71, 0xf1, 0x2c,
+  0x39, 0x69, 0xd9, 0x99, 0xbc, 0xfd, 0xe9, 0x6e, 0x4a, 0xa4, 0x39, 0x2f, 0xef, 0x92, 0x0d, 0x97,
+  0x7b, 0x9c, 0x87, 0x09, 0x7a, 0x3f, 0x4e, 0x14, 0xac, 0xd7, 0x90, 0xf5, 0x54, 0x09, 0x8c, 0xc4,
+  0xce, 0xe4, 0x32, 0xd9, 0x80, 0x1e, 0xdf, 0xe3, 0x63, 0x87, 0x3a, 0x4e, 0x64, 0xc4, 0x42, 0x67,
+  0x72, 0xad, 0x3f, 0xab, 0xac, 0xec, 0x7d, 0x16, 0xec, 0xa4, 0xab, 0x28, 0xcd, 0x14, 0x53, 0xab,
+  0x6c, 0xc6, 0xea, 0x3c, 0xe5, 0xa4, 0xda, 0x03, 0xcd, 0x89, 0x1a, 0x29, 0x69, 0x1e, 0xe8, 0x31,
+  0x98, 0x5c, 0x48, 0xfe, 0x9f, 0x15, 0x8f, 0xfd, 0xed, 0x00, 0x8f, 0x7a, 0x50, 0x9d, 0x29, 0xf1,
+  0xe7, 0x39, 0x4d, 0x15, 0xdb, 0x12, 0xce, 0x91, 0x4f, 0x60, 0xbe, 0x12, 0x49, 0x8c, 0xc2, 0x54,
+  0x28, 0x0b, 0x12, 0xe2, 0x94, 0x87, 0xdc, 0x57, 0x26, 0x76, 0x68, 0x34, 0xa7, 0xc0, 0xd5, 0x90,
+  0x7a, 0xba, 0xb6, 0x42, 0xc4, 0xe9, 0x4a, 0x81, 0xda, 0xa6, 0xb8, 0x20, 0x5b, 0xcd, 0x22, 0xa1,
+  0x1c, 0x58, 0xb3, 0x70, 0x85, 0x5f, 0x6f, 0xb9, 0xaa, 0xa0, 0x8f, 0x3a, 0xc4, 0x41, 0xc1, 0x77,
+  0x21, 0x03, 0x3e, 0xc9, 0x83, 0x02, 0xdf, 0x20, 0x87, 0x42, 0xf2, 0x60, 0x57, 0x5e, 0xcd, 0x51,
+  0x84, 0xc1, 0x64, 0x1d, 0x12, 0x4f, 0xcf, 0xe2, 0xdc, 0xf2, 0x38, 0xc3, 0x33, 0x72, 0x08, 0x25,
+  0xd3, 0x53, 0x2f, 0x42, 0x79, 0x87, 0xa6, 0x3b, 0x88, 0x51, 0xda, 0xf4, 0x65, 0xdc, 0x68, 0xd2,
+  0xc3, 0xdc, 0x6c, 0x33, 0x16, 0xb3, 0x70, 0x9b, 0x89, 0x97, 0x41, 0x4d, 0xd7, 0x5c, 0xe2, 0x01,
+  0x57, 0xda, 0x79, 0xde, 0xc9, 0x44, 0x71, 0x6d, 0xdd, 0x83, 0xd8, 0x89, 0xa5, 0xc5, 0xf8, 0xa8,
+  0x44, 0xc4, 0x0f, 0xe1, 0xe3, 0xa7, 0x76, 0xbe, 0xdc, 0x17, 0xaf, 0x31, 0x3e, 0xc1, 0x39, 0xd9,
+  0x92, 0x69, 0xd8, 0x8a, 0x1f, 0x13, 0x84, 0x4a, 0xaa, 0xcc, 0xd6, 0xe3, 0x82, 0xfd, 0xfc, 0x41,
+  0x64, 0x2a, 0x91, 0xdb, 0x41, 0xf5, 0x18, 0x7d, 0xe6, 0x40, 0x12, 0xfb, 0xa1, 0xf0, 0xef, 0xe9,
+  0x74, 0xb2, 0xc0, 0xd2, 0xb8, 0x6f, 0xbe, 0xfe, 0xb2, 0xdb, 0x6d, 0x0e, 0x25, 0x57, 0x2b, 0x19,
+  0xc3, 0x9c, 0x85, 0x18, 0x6d, 0x9d, 0x49, 0xff, 0xcb, 0xe5, 0xee, 0x39, 0x3c, 0x06, 0xf0, 0xcd,
+  0xe7, 0x87, 0x21, 0xbe, 0x81, 0x80, 0x6d, 0xb3, 0x97, 0xa2, 0x9c, 0x76, 0x8f, 0xc0, 0x9c, 0x76,
+  0x0b, 0x9c, 0x42, 0x4c, 0x9f, 0xc5, 0x6b, 0x96, 0x69, 0x8d, 0x2c, 0xcd, 0x7a, 0x07, 0x4c, 0x76,
+  0x75, 0x4e, 0xbb, 0x5d, 0x07, 0x96, 0x9c, 0xd2, 0xc2, 0xd8, 0xe9, 0xf5, 0xbb, 0xa4, 0x23, 0x43,
+  0x3e, 0xa9, 0x87, 0x05, 0x1d, 0xaa, 0xf1, 0x84, 0x15, 0x59, 0xad, 0xeb, 0xbd, 0xc1, 0xa4, 0xe6,
+  0x58, 0xb7, 0xa5, 0xec, 0xa9, 0x58, 0x8c, 0xa1, 0xd1, 0xf5, 0xa3, 0x66, 0x0b, 0xc8, 0xdb, 0x40,
+  0xae, 0xe2, 0x98, 0xe2, 0xb4, 0x88, 0x61, 0x21, 0x39, 0x8f, 0x8f, 0xa8, 0x7f, 0xe7, 0xc8, 0x67,
+  0x5c, 0xe1, 0xa9, 0xb1, 0x27, 0x72, 0x14, 0xb2, 0x19, 0x0f, 0x01, 0x29, 0x50, 0x7e, 0x3a, 0x48,
+  0x57, 0x08, 0x76, 0x89, 0x09, 0x26, 0x44, 0xf7, 0xd1, 0x73, 0x96, 0xae, 0x7a, 0xbe, 0x29, 0x63,
+  0x39, 0x39, 0xc7, 0x26, 0xcb, 0x9e, 0x62, 0x5e, 0xb5, 0x31, 0x82, 0x60, 0x6c, 0xe4, 0xd0, 0x8f,
+  0x36, 0x0a, 0x38, 0x13, 0xf0, 0xa3, 0x57, 0xcf, 0xc5, 0x8a, 0x9f, 0x52, 0xac, 0x2b, 0xb8, 0x63,
+  0xfc, 0x30, 0x0f, 0x14, 0xfb, 0x01, 0xd4, 0x54, 0x2d, 0x47, 0x1d, 0xee, 0x42, 0xc8, 0x68, 0xc3,
+  0x64, 0x2d, 0x05, 0xcc, 0xed, 0xd8, 0xde, 0x22, 0x0c, 0x4f, 0x94, 0xed, 0x32, 0xd8, 0x48, 0xa1,
+  0x78, 0x56, 0x5d, 0x13, 0xaf, 0x33, 0x33, 0xf8, 0x44, 0xca, 0x5b, 0x59, 0x8e, 0x0d, 0xe7, 0xc5,
+  0xd6, 0x35, 0x07, 0x29, 0x88, 0x25, 0x9f, 0x25, 0x09, 0x46, 0xc3, 0x1b, 0xfd, 0xa9, 0x9d, 0x71,
+  0x94, 0xf9, 0x52, 0xa4, 0x3a, 0x98, 0xae, 0x99, 0x84, 0x05, 0x82, 0x6c, 0xd8, 0x16, 0xc6, 0xf0,
+  0xaf, 0x4d, 0x36, 0xe8, 0x74, 0xfe, 0xf2, 0xb8, 0x11, 0x71, 0x90, 0x6c, 0x3c, 0xac, 0x96, 0xf4,
+  0xf9, 0xf3, 0x96, 0x49, 0xa6, 0x48, 0xbd, 0x1f, 0x3b, 0x9b, 0xec, 0x5f, 0x43, 0xbb, 0x6c, 0xc3,
+  0x67, 0x19, 0x96, 0x53, 0x5c, 0xd1, 0x80, 0x5d, 0x81, 0x55, 0xc4, 0x39, 0x56, 0x0a, 0xea, 0x12,
+  0x5d, 0x87, 0xc7, 0x5c, 0xba, 0xda, 0xc3, 0x9d, 0x16, 0x7a, 0xfc, 0x25, 0x3e, 0x34, 0x89, 0x74,
+  0xbe, 0x8a, 0xb5, 0x5f, 0xe8, 0xca, 0xef, 0x3d, 0x9f, 0xdd, 0x6a, 0x10, 0x17, 0xab, 0x0b, 0x6d,
+  0x2a, 0xac, 0xf7, 0xb0, 0x5a, 0xe1, 0xb8, 0xf9, 0xc2, 0x75, 0xee, 0xe4, 0x96, 0xbc, 0x4d, 0x25,
+  0x90, 0xa4, 0x58, 0x35, 0x30, 0x28, 0xe8, 0x89, 0x2e, 0x36, 0x51, 0xc7, 0xf3, 0x3c, 0x47, 0x23,
+  0x43, 0xc9, 0x13, 0x0a, 0x13, 0xf3, 0x4d, 0x49, 0xee, 0x5a, 0x21, 0x77, 0xe9, 0xbc, 0x24, 0xd6,
+  0xc8, 0xf8, 0x33, 0x46, 0x26, 0xb1, 0x10, 0x89, 0xf7, 0x29, 0xfc, 0x30, 0xc9, 0xb8, 0xa5, 0x38,
+  0xa3, 0xe7, 0x7d, 0x92, 0x88, 0x67, 0x19, 0x5b, 0x70, 0x4d, 0x72, 0x65, 0x9e, 0x87, 0xd0, 0xe9,
+  0xc0, 0xa8, 0xdd, 0x06, 0x54, 0x0a, 0x16, 0x64, 0x22, 0x03, 0xaa, 0x41, 0x71, 0xe5, 0xc7, 0xaa,
+  0x12, 0xcc, 0x9e, 0xba, 0xbe, 0x52, 0x07, 0x55, 0x70, 0x56, 0xc8, 0xa9, 0x75, 0xc0, 0x03, 0x23,
+  0xeb, 0x0e, 0x88, 0x66, 0xeb, 0x65, 0x28, 0x5a, 0x9a, 0x20, 0xd7, 0x18, 0x1e, 0xcd, 0x3b, 0x0c,
+  0xa9, 0xc9, 0x4a, 0xb9, 0x35, 0x7b, 0xb4, 0xa0, 0xdf, 0xa5, 0x58, 0x64, 0xb7, 0x42, 0x51, 0x4c,
+  0xfa, 0x00, 0xe3, 0x7c, 0x19, 0xee, 0x19, 0x6e, 0xc1, 0x67, 0x52, 0x6e, 0x51, 0x38, 0x0e, 0x73,
+  0xc1, 0xc3, 0x20, 0xc3, 0x47, 0x86, 0xa6, 0x59, 0xb2, 0x78, 0xc1, 0x03, 0x70, 0x1b, 0xeb, 0x06,
+  0x88, 0x4c, 0xcf, 0x9b, 0x65, 0x80, 0xb9, 0x20, 0x43, 0x26, 0x9a, 0x2d, 0x83, 0xb9, 0x11, 0x58,
+  0xa9, 0x32, 0x14, 0x24, 0x0c, 0x21, 0x8b, 0xb1, 0xce, 0x5d, 0x26, 0x0a, 0xe6, 0x32, 0x89, 0x80,
+  0xe2, 0x3c, 0xd9, 0x9d, 0x3e, 0x07, 0x10, 0x71, 0x89, 0xca, 0x45, 0x9c, 0x08, 0xbd, 0x86, 0x46,
+  0x11, 0xd1, 0x64, 0x3e, 0xb4, 0x02, 0xdc, 0xc7, 0xc9, 0xc6, 0x3a, 0xa5, 0x1d, 0x1c, 0xc3, 0xe3,
+  0xc7, 0x61, 0x6d, 0xe8, 0x67, 0xb3, 0x31, 0xce, 0xb4, 0x7b, 0x85, 0x07, 0x33, 0x41, 0xc7, 0xf0,
+  0x02, 0x77, 0xbf, 0xcd, 0xd7, 0x99, 0xa0, 0x5b, 0x57, 0xae, 0x35, 0xe8, 0x13, 0xea, 0x7d, 0x7f,
+  0x0b, 0xd3, 0x18, 0x2c, 0xdd, 0xc0, 0x81, 0x2f, 0x40, 0xd3, 0x7a, 0x74, 0x63, 0xb1, 0x8a, 0x8e,
+  0xb2, 0x05, 0xc2, 0xff, 0xe3, 0x76, 0x7a, 0xed, 0xa5, 0x4c, 0xe6, 0xc6, 0x32, 0x14, 0x9a, 0x40,
+  0xcc, 0xc1, 0x45, 0x22, 0x4f, 0x2b, 0x63, 0x3c, 0x86, 0x5e, 0xbe, 0x13, 0x94, 0x52, 0xe1, 0xfc,
+  0xd0, 0x8e, 0x3d, 0xc9, 0x3c, 0xfd, 0xa0, 0x7a, 0xef, 0x50, 0x4d, 0x29, 0xb9, 0x25, 0x1a, 0x81,
+  0x30, 0x84, 0x3f, 0xd0, 0xaa, 0xd3, 0x91, 0xcf, 0x1a, 0x2b, 0x46, 0x3e, 0xa4, 0x35, 0x19, 0x0a,
+  0x85, 0x5a, 0xd7, 0x46, 0xd1, 0x36, 0xad, 0x9a, 0x25, 0xb3, 0xb0, 0x41, 0xe2, 0xaf, 0x22, 0xe2,
+  0x7c, 0xc1, 0xd5, 0x79, 0xc8, 0xe9, 0xf1, 0xbb, 0xed, 0xdf, 0x03, 0x37, 0x0f, 0x90, 0x4d, 0x4f,
+  0xa0, 0xab, 0x49, 0xba, 0x41, 0x1a, 0x86, 0x3d, 0x33, 0x81, 0x3a, 0x69, 0xa0, 0x47, 0xe0, 0x07,
+  0x8d, 0x59, 0x3f, 0xa0, 0xc1, 0x66, 0x63, 0xf8, 0x1c, 0x74, 0x11, 0x48, 0xf7, 0xc1, 0xf3, 0xa9,
+  0x67, 0x31, 0xca, 0xc0, 0xba, 0x0f, 0x52, 0xcc, 0xe5, 0x28, 0xe4, 0x1d, 0x94, 0x55, 0x70, 0xfe,
+  0x38, 0x53, 0x94, 0x6a, 0x9a, 0xf9, 0x0a, 0xb2, 0x5e, 0x41, 0x4a, 0x89, 0x6f, 0xcd, 0x2d, 0x35,
+  0x9c, 0x8c, 0x35, 0x56, 0x53, 0xff, 0xf6, 0xb4, 0xee, 0xed, 0xbe, 0xa6, 0x94, 0xac, 0x18, 0xac,
+  0xa8, 0xb4, 0xf1, 0xac, 0x93, 0xf3, 0x65, 0xe0, 0x92, 0x21, 0xcc, 0x17, 0x63, 0x36, 0xb2, 0xa5,
+  0x50, 0xf8, 0x2f, 0x0e, 0xf8, 0x03, 0xe5, 0x61, 0x73, 0xfa, 0x8c, 0x16, 0xcc, 0x35, 0xb2, 0x59,
+  0x95, 0x02, 0x11, 0x9f, 0x94, 0x82, 0xea, 0xeb, 0x9a, 0x14, 0x34, 0xe2, 0xd9, 0xed, 0xbd, 0x90,
+  0xc7, 0x0b, 0xf4, 0x86, 0x13, 0xab, 0x6c, 0x9c, 0xc2, 0x99, 0x7c, 0xb8, 0x74, 0x50, 0xd0, 0xfb,
+  0xd4, 0xf4, 0xea, 0x38, 0xc3, 0x62, 0xb2, 0xb6, 0x16, 0x53, 0xec, 0x39, 0xf3, 0x97, 0x6e, 0x7e,
+  0xc0, 0x5c, 0x9d, 0xf3, 0x5b, 0x46, 0x20, 0xba, 0x63, 0x6a, 0x28, 0x0c, 0x9a, 0x2e, 0x45, 0xf0,
+  0x69, 0xba, 0x4f, 0xd3, 0xc4, 0xcb, 0x66, 0xc1, 0xb2, 0xb9, 0xac, 0x7e, 0x04, 0x8e, 0xae, 0x5f,
+  0x9c, 0xa1, 0x35, 0x71, 0x5c, 0x3f, 0xf8, 0x5f, 0x40, 0x0f, 0x7e, 0xff, 0x7d, 0xff, 0xd8, 0x94,
+  0x42, 0xa0, 0xfe, 0xdf, 0x73, 0x88, 0x44, 0x86, 0xe1, 0x11, 0x30, 0x1d, 0x9b, 0x90, 0xd5, 0x02,
+  0x96, 0xdd, 0x53, 0xb5, 0xb2, 0x17, 0xa7, 0x58, 0x8c, 0x05, 0xee, 0x02, 0x2f, 0x63, 0xbc, 0x08,
+  0x8a, 0xab, 0x58, 0x89, 0x90, 0x2c, 0x12, 0x57, 0x14, 0x7a, 0x72, 0x60, 0xcf, 0x32, 0x77, 0xe0,
+  0x45, 0x80, 0xcc, 0x80, 0x73, 0xa5, 0x19, 0x0e, 0x9d, 0x6d, 0x25, 0x57, 0x85, 0x93, 0x9b, 0x02,
+  0x71, 0x58, 0x95, 0x3c, 0x17, 0x62, 0x3a, 0xfb, 0x37, 0xc6, 0x79, 0x8f, 0x65, 0x19, 0xb2, 0xe6,
+  0x1a, 0x15, 0xb4, 0xc8, 0x00, 0x16, 0xdc, 0xa8, 0x6b, 0x37, 0x26, 0x6a, 0x9d, 0xd9, 0x84, 0xb0,
+  0x4c, 0x36, 0x66, 0x53, 0xbb, 0x7a, 0x3f, 0xdd, 0x54, 0x48, 0x08, 0xd8, 0xee, 0xad, 0x63, 0xad,
+  0xae, 0x1c, 0x75, 0x31, 0x67, 0x51, 0xcd, 0xc8, 0xb0, 0xa0, 0x90, 0x6c, 0x63, 0x86, 0xc2, 0x0a,
+  0x51, 0x31, 0x58, 0xd2, 0x85, 0x78, 0xf5, 0x4e, 0xef, 0x79, 0x96, 0x62, 0x6c, 0x37, 0xa1, 0xd3,
+  0xd5, 0x96, 0xc5, 0xaf, 0xd0, 0xd6, 0x8b, 0x0c, 0x05, 0x3e, 0x45, 0xa8, 0xcf, 0x0e, 0xf4, 0x28,
+  0x5d, 0x79, 0x2a, 0xb9, 0x10, 0x0f, 0x3c, 0x70, 0xfb, 0xcd, 0x12, 0xaa, 0xb8, 0x70, 0x42, 0xe9,
+  0xc5, 0xfa, 0x7b, 0x49, 0x62, 0x0e, 0xe2, 0x81, 0x53, 0x49, 0x93, 0xb6, 0x07, 0x61, 0x67, 0xed,
+  0xb7, 0x72, 0xba, 0x72, 0x77, 0xca, 0x65, 0x2e, 0x47, 0x4a, 0x32, 0x7d, 0x87, 0x4f, 0xef, 0x2d,
+  0x89, 0xfd, 0xb6, 0x37, 0x4d, 0xe9, 0x4e, 0xd6, 0x69, 0xf4, 0x50, 0x49, 0x58, 0xbf, 0x00, 0x21,
+  0xe9, 0x15, 0x53, 0x4b, 0x4f, 0xb7, 0x64, 0xac, 0x86, 0xb0, 0x54, 0xce, 0xa7, 0xa3, 0xcc, 0x2a,
+  0x0b, 0xd5, 0x56, 0x28, 0xa9, 0x22, 0x99, 0xbd, 0x9a, 0x11, 0x26, 0xf5, 0x81, 0x0e, 0xa0, 0xe5,
+  0x24, 0xe8, 0xa5, 0x2f, 0x04, 0x4b, 0x8b, 0xeb, 0xa0, 0xce, 0xe1, 0x56, 0x6b, 0x07, 0x27, 0x9f,
+  0x5a, 0xac, 0x63, 0x28, 0xee, 0x1b, 0x1c, 0x45, 0x28, 0x28, 0x9e, 0x82, 0xc1, 0x5b, 0xa7, 0x5c,
+  0x3d, 0xcd, 0x49, 0x49, 0x62, 0x80, 0x8e, 0xc6, 0x4a, 0x7b, 0x67, 0xaf, 0xe7, 0x8f, 0xaa, 0xcb,
+  0x63, 0x36, 0x7b, 0x1d, 0xcf, 0xb2, 0x74, 0xe8, 0x47, 0x26, 0xd5, 0xed, 0x7a, 0x31, 0xe5, 0xc0,
+  0x8c, 0xfb, 0x86, 0x88, 0x2d, 0x92, 0xa6, 0xae, 0xd7, 0x6f, 0xd8, 0x66, 0x00, 0x44, 0xbe, 0x73,
+  0x38, 0x90, 0xda, 0x8f, 0x1a, 0xcf, 0x30, 0x55, 0xb6, 0x53, 0xea, 0x7c, 0xed, 0x78, 0xf9, 0xd1,
+  0xf5, 0xb6, 0x9d, 0xb1, 0x93, 0x14, 0xcd, 0x79, 0x20, 0x76, 0x9f, 0xe7, 0x20, 0xef, 0xd1, 0xd5,
+  0x21, 0x6a, 0xe7, 0xe4, 0xe8, 0xda, 0xa2, 0x4b, 0xb6, 0x9f, 0x94, 0xf3, 0x29, 0x5d, 0x0b, 0xc1,
+  0xb7, 0xd0, 0xb8, 0x9c, 0xbe, 0x87, 0x77, 0xd3, 0xf7, 0xe7, 0x37, 0xe0, 0x6e, 0x30, 0xc2, 0xe2,
+  0x75, 0x09, 0x53, 0x5d, 0x03, 0x50, 0x75, 0xd7, 0xd3, 0x9b, 0xab, 0xb7, 0x97, 0xcf, 0xf1, 0x59,
+  0x6d, 0x72, 0xec, 0xd8, 0x70, 0xf7, 0xc0, 0x1e, 0xc5, 0xd8, 0x69, 0x3f, 0xd4, 0x61, 0x76, 0x8e,
+  0x26, 0x6a, 0x2f, 0xb3, 0x3c, 0xe1, 0xe9, 0x8a, 0xca, 0x6e, 0xcd, 0x53, 0xf9, 0xb8, 0xd2, 0xd3,
+  0x69, 0x1e, 0x5a, 0x3b, 0x63, 0xf2, 0x65, 0xcb, 0xa9, 0xcd, 0x67, 0x11, 0x28, 0x09, 0x15, 0x41,
+  0x6c, 0x0c, 0x0d, 0x6a, 0x60, 0x36, 0xe0, 0xf5, 0xeb, 0x32, 0x26, 0xd5, 0xaa, 0xcd, 0xfa, 0x86,
+  0x35, 0x09, 0x1b, 0xd3, 0x6b, 0xe3, 0xd8, 0xb5, 0x70, 0x45, 0x6e, 0x82, 0x1e, 0x53, 0x16, 0x72,
+  0x7b, 0x2c, 0xd7, 0x41, 0x46, 0x81, 0x58, 0xd7, 0xef, 0xf2, 0xfd, 0x37, 0xd4, 0x30, 0xb7, 0xfd,
+  0x72, 0xdd, 0xcb, 0x2e, 0x1b, 0xcd, 0x03, 0xdd, 0x68, 0x18, 0x9a, 0x76, 0xf3, 0x66, 0x89, 0x65,
+  0xda, 0x30, 0xef, 0x56, 0x7f, 0x95, 0x3e, 0x40, 0xe5, 0xdf, 0xd0, 0xd1, 0xbd, 0x32, 0x9c, 0x19,
+  0x75, 0x70, 0x0b, 0x73, 0x19, 0x6e, 0x0c, 0x77, 0x0b, 0x84, 0xe7, 0x54, 0xd1, 0x7d, 0xa1, 0x2a,
+  0x2e, 0x2e, 0xfe, 0x24, 0x81, 0x25, 0x86, 0xb4, 0x97, 0x89, 0x7b, 0x8d, 0x65, 0x48, 0xfa, 0x89,
+  0x22, 0x5f, 0x4c, 0x6f, 0xce, 0xce, 0xbf, 0xa7, 0x7e, 0x77, 0xe3, 0x65, 0x82, 0xea, 0xfe, 0x78,
+  0x00, 0x7f, 0x9e, 0xbc, 0x68, 0xe0, 0xed, 0x0b, 0x05, 0xce, 0x79, 0x99, 0xcf, 0xe9, 0x32, 0xfd,
+  0xc9, 0x32, 0x5f, 0x7f, 0xa2, 0xc8, 0xff, 0x1f, 0xde, 0x8e, 0x35, 0xbb, 0xe6, 0xb7, 0x79, 0x54,
+  0x1f, 0x2f, 0x91, 0xf9, 0xa7, 0xeb, 0x1f, 0xaf, 0xa7, 0xef, 0xaf, 0xe1, 0x6a, 0xfa, 0xfd, 0xf9,
+  0xc9, 0xc9, 0xc9, 0xff, 0x80, 0x78, 0xd6, 0x0a, 0xc7, 0xcf, 0xf4, 0x13, 0x79, 0x5f, 0xc4, 0xf3,
+  0x44, 0xb3, 0x57, 0x6d, 0x75, 0xea, 0xf7, 0x5e, 0x01, 0xf7, 0x13, 0x69, 0xfb, 0xca, 0xc8, 0x11,
+  0x97, 0xe4, 0x49, 0xb8, 0xdb, 0x59, 0x12, 0xcf, 0xc5, 0x62, 0x65, 0xa7, 0xaa, 0xcd, 0x37, 0xbb,
+  0xdd, 0x91, 0x4d, 0xbe, 0xc0, 0x5d, 0x7e, 0x59, 0xf5, 0xbb, 0xfd, 0xbe, 0xce, 0xe1, 0x4f, 0x96,
+  0x20, 0xd6, 0x77, 0x56, 0xa6, 0x81, 0xd2, 0xfa, 0x23, 0xd0, 0xf7, 0x71, 0xe7, 0x73, 0xaf, 0x0a,
+  0xac, 0xcf, 0xc2, 0x53, 0xe5, 0x55, 0x2d, 0xf8, 0x1f, 0xcf, 0xf2, 0x3b, 0x6d, 0xfc, 0x7a, 0xea,
+  0x6b, 0x1c, 0x66, 0xce, 0x88, 0xb0, 0x63, 0x05, 0x63, 0x7c, 0x0c, 0x72, 0xce, 0xe4, 0xad, 0xbe,
+  0x28, 0x43, 0xfe, 0x3a, 0x01, 0xca, 0x57, 0x09, 0x5a, 0x02, 0xd3, 0x05, 0xd2, 0xaf, 0x3c, 0x6b,
+  0xd2, 0x17, 0xf5, 0xaa, 0xad, 0xa7, 0x3c, 0x6b, 0xad, 0xc3, 0x4e, 0xff, 0xc7, 0x8b, 0x54, 0xba,
+  0xdf, 0xc7, 0x57, 0xa6, 0x91, 0x65, 0x9b, 0xf8, 0xd4, 0x47, 0x91, 0xc8, 0x6c, 0xc7, 0x36, 0xe5,
+  0xa9, 0x3a, 0x0c, 0x32, 0x38, 0xbb, 0xfd, 0x19, 0x58, 0x28, 0x39, 0x0b, 0xb6, 0xc8, 0xcd, 0x26,
+  0xce, 0x58, 0x94, 0x86, 0xa8, 0xfa, 0x99, 0xe9, 0x9d, 0xd1, 0xfb, 0x71, 0x99, 0x84, 0x21, 0x97,
+  0x06, 0xcc, 0x25, 0x6e, 0x5a, 0x68, 0xcf, 0x56, 0xc4, 0x19, 0xfe, 0x62, 0x0f, 0x2d, 0xbc, 0xfa,
+  0x8b, 0xa0, 0x45, 0xc7, 0xb0, 0xe7, 0x79, 0x5e, 0x93, 0x1a, 0xaa, 0x1c, 0xc3, 0x92, 0x88, 0x31,
+  0xfe, 0x63, 0x4c, 0x5a, 0x26, 0x52, 0xfc, 0x86, 0x28, 0x2c, 0x84, 0x14, 0xef, 0x3f, 0x61, 0xf5,
+  0xb6, 0x56, 0x7d, 0xc7, 0x80, 0xba, 0x4a, 0x90, 0xa1, 0xea, 0x95, 0xcd, 0xbe, 0x49, 0x78, 0xa2,
+  0xa6, 0xc8, 0x5f, 0x30, 0xd8, 0x6a, 0x62, 0xce, 0x15, 0xde, 0xde, 0x9d, 0x5c, 0xc4, 0x6f, 0xa9,
+  0x5d, 0x37, 0x6e, 0x53, 0xcf, 0xcb, 0xa2, 0xe3, 0x93, 0xf3, 0x5a, 0xf3, 0x96, 0x8d, 0x69, 0xd8,
+  0xec, 0xe0, 0xe9, 0xe0, 0x80, 0x37, 0x34, 0x2c, 0xdd, 0xca, 0xbb, 0xbf, 0xc4, 0xda, 0x38, 0x89,
+  0x33, 0x4e, 0xf7, 0x7e, 0xfb, 0xda, 0x23, 0x1f, 0xf2, 0xe8, 0xb4, 0xba, 0xfa, 0xae, 0xbf, 0xb3,
+  0xc8, 0xcf, 0xd6, 0xa5, 0xc3, 0xea, 0x4b, 0x65, 0xb2, 0x21, 0x09, 0x70, 0xdc, 0x53, 0x52, 0x44,
+  0x6e, 0xd3, 0xcb, 0xd2, 0x50, 0x28, 0xd7, 0xf9, 0x25, 0x46, 0xa3, 0xce, 0x45, 0xa8, 0xb8, 0xac,
+  0xf4, 0x1b, 0xf0, 0xbc, 0x57, 0xf6, 0xa3, 0xaf, 0x1f, 0xba, 0xbf, 0xc2, 0x64, 0x0c, 0x4e, 0xd7,
+  0xa1, 0x5a, 0x20, 0x1f, 0x19, 0xe1, 0xc8, 0x5f, 0x1d, 0xcd, 0x40, 0xc4, 0xd2, 0x27, 0x01, 0xf2,
+  0x0d, 0x5b, 0x8e, 0xa1, 0xbd, 0x5e, 0x45, 0x33, 0x2e, 0x6b, 0x8d, 0x0a, 0xad, 0x6c, 0xf5, 0x40,
+  0x7c, 0x1a, 0x85, 0xa0, 0x9e, 0xcf, 0xe8, 0x7f, 0x46, 0xa0, 0x94, 0x4e, 0x3f, 0x28, 0x6f, 0xff,
+  0x48, 0xe4, 0xf9, 0x21, 0x67, 0xf2, 0x06, 0x3d, 0xce, 0xed, 0xb6, 0x00, 0xff, 0x56, 0x75, 0x58,
+  0x7c, 0x33, 0x2f, 0x79, 0x6a, 0xcd, 0x1b, 0xd2, 0x44, 0xde, 0xb4, 0x19, 0x41, 0xbf, 0x59, 0x6b,
+  0x15, 0xd8, 0x0b, 0x64, 0x17, 0x59, 0x20, 0x3a, 0x14, 0x11, 0xff, 0xb6, 0x40, 0xf5, 0xf2, 0x81,
+  0xea, 0xea, 0x36, 0xf4, 0x68, 0xba, 0xba, 0x12, 0x2b, 0xf2, 0xfc, 0x86, 0x88, 0xce, 0xe9, 0xb1,
+  0x34, 0x0d, 0xb7, 0x6e, 0xbc, 0x0a, 0xc3, 0x96, 0x5e, 0x5e, 0x57, 0x92, 0xac, 0x9a, 0xf4, 0x43,
+  0xef, 0x57, 0x52, 0x05, 0xfa, 0xed, 0x12, 0x59, 0x2e, 0x40, 0xd8, 0xc3, 0x27, 0x81, 0x9c, 0x1a,
+  0x90, 0x2a, 0x4b, 0xa4, 0xce, 0x82, 0x5a, 0x55, 0xa8, 0x5d, 0x85, 0x12, 0xa8, 0x2e, 0xdd, 0x53,
+  0xf3, 0xbd, 0x5c, 0x14, 0x94, 0xc6, 0x5a, 0x14, 0xef, 0x3e, 0x07, 0xb7, 0xaa, 0x53, 0x12, 0x97,
+  0xac, 0x55, 0xc5, 0xde, 0x56, 0xb1, 0xfd, 0xa8, 0x02, 0xde, 0xeb, 0xa2, 0x5b, 0xe3, 0x10, 0xae,
+  0x0a, 0xcd, 0x5d, 0xb8, 0xd8, 0x43, 0xcb, 0xa7, 0x87, 0x77, 0xb6, 0x31, 0xc6, 0xc2, 0xa9, 0x7e,
+  0xb7, 0xba, 0x11, 0x19, 0x1b, 0x1d, 0x34, 0xbc, 0xa5, 0xd8, 0x48, 0x6d, 0x33, 0xb9, 0x98, 0x31,
+  0x34, 0x7a, 0xef, 0xeb, 0x6e, 0x0b, 0xff, 0x78, 0xa7, 0xcd, 0xa2, 0x8f, 0xa6, 0xd5, 0xb3, 0xd7,
+  0x3d, 0x93, 0x2d, 0x10, 0xc4, 0x9a, 0xb6, 0xfe, 0x87, 0xaf, 0xd0, 0x8f, 0xa1, 0x4b, 0x4e, 0x2c,
+  0xe8, 0xa1, 0x59, 0xe0, 0x6b, 0x5f, 0x7a, 0xd0, 0xfe, 0xf1, 0x41, 0xe4, 0xc6, 0x6d, 0xee, 0xb8,
+  0x52, 0x0b, 0x90, 0x82, 0xc6, 0x91, 0x60, 0x8f, 0x96, 0x3a, 0x68, 0x2d, 0x68, 0xd7, 0xc5, 0xf9,
+  0x1c, 0xf4, 0x9e, 0xba, 0x19, 0x50, 0xf3, 0x76, 0xda, 0x77, 0xc6, 0xb1, 0x02, 0x78, 0x87, 0x9a,
+  0x71, 0x9b, 0x2f, 0x94, 0x01, 0xaf, 0x79, 0xb4, 0x90, 0x4e, 0xd4, 0x5d, 0xe2, 0x5a, 0x66, 0x5a,
+  0xb0, 0xc5, 0x87, 0xfe, 0xaf, 0xcd, 0x26, 0xde, 0xf5, 0x68, 0x3a, 0xc2, 0xa8, 0x7c, 0x68, 0x7a,
+  0x77, 0xff, 0x0c, 0xa3, 0xea, 0x3d, 0x2f, 0x34, 0x3b, 0x0b, 0x57, 0xdc, 0xd9, 0x9f, 0x77, 0x9b,
+  0x47, 0x6d, 0x31, 0x0b, 0xb1, 0x70, 0x71, 0x76, 0xa7, 0xef, 0xe8, 0xc4, 0xa2, 0x81, 0x8b, 0x66,
+  0x53, 0x0f, 0x79, 0xe8, 0xa3, 0xb9, 0xbb, 0xcd, 0x83, 0xa4, 0xe4, 0x12, 0xbb, 0xb4, 0x7b, 0x4e,
+  0x91, 0xb7, 0xe7, 0x6c, 0xb7, 0xad, 0xfe, 0x02, 0x82, 0xde, 0x9d, 0xd5, 0xdf, 0x3e, 0xec, 0xbc,
+  0x3b, 0x1b, 0x16, 0x83, 0xdf, 0xad, 0x94, 0x42, 0x8d, 0xda, 0x91, 0x03, 0xaf, 0xb9, 0x77, 0x9b,
+  0x79, 0xd5, 0x45, 0x16, 0xbc, 0xd3, 0x39, 0x9a, 0x0b, 0x66, 0x9a, 0x12, 0x83, 0xdc, 0xfe, 0x9b,
+  0x3e, 0xfd, 0x4a, 0xdb, 0xc1, 0x70, 0x92, 0x2c, 0x16, 0x78, 0x31, 0xdf, 0xdb, 0xc8, 0x8c, 0xbb,
+  0xcd, 0xc7, 0x9d, 0x97, 0x67, 0xa6, 0x01, 0x6a, 0x66, 0xf3, 0x77, 0x5b, 0x98, 0xcf, 0xcd, 0x2b,
+  0x4a, 0x00, 0x7c, 0x36, 0xff, 0x87, 0x68, 0xd4, 0x31, 0xff, 0x1f, 0xed, 0xbf, 0x63, 0x44, 0x28,
+  0xc8, 0xa6, 0x26, 0x00, 0x00,
+};
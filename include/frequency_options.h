@@ -0,0 +1,110 @@
+#pragma once
+
+// SENSOR READ FREQUENCY OPTIONS
+// -----------------------------
+// How often we check water and make decisions: more frequently (seconds) for
+// debug, every N minutes for production. This table is the single source for
+// everything that shows or selects a frequency: the labels (OLED, web page,
+// Serial), the web page <select> options and the bounds checks.
+//
+// Labels and the JSON list of labels are built at compile time, nothing is
+// formatted at run time.
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct FrequencyOption {
+  uint16_t seconds;
+  char label[10];         // "5 sec", "15 min", "2 hrs"...
+};
+
+namespace frequency_options_detail {
+  constexpr size_t appendText(char *out, size_t at, const char *text) {
+    while (*text) out[at++] = *text++;
+    return at;
+  }
+  constexpr size_t appendNumber(char *out, size_t at, unsigned value) {
+    char digits[6] = {};
+    size_t n = 0;
+    do {
+      digits[n++] = '0' + value % 10;
+      value /= 10;
+    } while (value > 0);
+    while (n > 0) out[at++] = digits[--n];
+    return at;
+  }
+
+  constexpr FrequencyOption makeOption(uint16_t seconds) {
+    FrequencyOption option{seconds, {}};
+    size_t at = 0;
+    if (seconds >= 3600 && seconds % 3600 == 0) {
+      at = appendNumber(option.label, at, seconds / 3600);
+      at = appendText(option.label, at, seconds == 3600 ? " hr" : " hrs");
+    } else if (seconds >= 60) {
+      at = appendNumber(option.label, at, seconds / 60);
+      at = appendText(option.label, at, " min");
+    } else {
+      at = appendNumber(option.label, at, seconds);
+      at = appendText(option.label, at, " sec");
+    }
+    option.label[at] = '\0';
+    return option;
+  }
+}
+
+constexpr FrequencyOption frequencyOptions[] = {
+  frequency_options_detail::makeOption(1),
+  frequency_options_detail::makeOption(5),
+  frequency_options_detail::makeOption(10),
+  frequency_options_detail::makeOption(15),
+  frequency_options_detail::makeOption(30),
+  frequency_options_detail::makeOption(60),
+  frequency_options_detail::makeOption(2 * 60),
+  frequency_options_detail::makeOption(5 * 60),
+  frequency_options_detail::makeOption(10 * 60),
+  frequency_options_detail::makeOption(15 * 60),
+  frequency_options_detail::makeOption(30 * 60),
+  frequency_options_detail::makeOption(45 * 60),
+  frequency_options_detail::makeOption(60 * 60),
+  frequency_options_detail::makeOption(120 * 60),
+};
+constexpr int FREQUENCY_OPTIONS_COUNT = sizeof(frequencyOptions) / sizeof(frequencyOptions[0]);
+constexpr int FREQUENCY_OPTION_DEFAULT = 5;   // 1 minute
+
+constexpr bool isValidFrequencyOption(int index) {
+  return index >= 0 && index < FREQUENCY_OPTIONS_COUNT;
+}
+
+namespace frequency_options_detail {
+  constexpr bool sortedAscending() {
+    for (int i = 1; i < FREQUENCY_OPTIONS_COUNT; i++) {
+      if (frequencyOptions[i].seconds <= frequencyOptions[i - 1].seconds) return false;
+    }
+    return true;
+  }
+
+  // ["1 sec","5 sec",...] for the web page <select> (the index is the option value)
+  struct LabelsJson {
+    char text[FREQUENCY_OPTIONS_COUNT * (sizeof(FrequencyOption::label) + 3) + 3];
+    size_t length;
+  };
+  constexpr LabelsJson makeLabelsJson() {
+    LabelsJson json{{}, 0};
+    size_t at = appendText(json.text, 0, "[");
+    for (int i = 0; i < FREQUENCY_OPTIONS_COUNT; i++) {
+      if (i > 0) at = appendText(json.text, at, ",");
+      at = appendText(json.text, at, "\"");
+      at = appendText(json.text, at, frequencyOptions[i].label);
+      at = appendText(json.text, at, "\"");
+    }
+    at = appendText(json.text, at, "]");
+    json.text[at] = '\0';
+    json.length = at;
+    return json;
+  }
+}
+
+static_assert(frequency_options_detail::sortedAscending(), "frequencyOptions: intervals must be sorted, shortest first");
+static_assert(isValidFrequencyOption(FREQUENCY_OPTION_DEFAULT), "frequencyOptions: default option out of range");
+
+constexpr frequency_options_detail::LabelsJson frequencyOptionsLabelsJson = frequency_options_detail::makeLabelsJson();
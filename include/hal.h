@@ -0,0 +1,134 @@
+#pragma once
+
+// HARDWARE ABSTRACTION LAYER
+// --------------------------
+// The controller logic in main.cpp only talks to the hardware through the
+// usual Arduino style APIs: clock (millis/delay), GPIO (digitalWrite...),
+// 433Mhz radio (RCSwitch), NVS (Preferences), flash file system (SPIFFS),
+// OLED display (Adafruit_SSD1306) and the websocket (AsyncWebSocket).
+//
+// - On the ESP32 (env:esp32doit-devkit-v1) this header simply pulls the real
+//   libraries, nothing changes for the firmware.
+// - On the host (env:native) it pulls hal_native.h which provides small
+//   simulated versions of the same APIs running on a simulated clock, so
+//   the whole loop() can be profiled / load-tested on Linux.
+//
+// On top of the libraries, the HAL provides startBackgroundService() to run
+// blocking work outside of loop() (a FreeRTOS task on the ESP32), and
+// idleWait() / wakeLoop() to let loop() sleep until there is work, lightSleep()
+// for the low power mode, and the stack low-water marks of those tasks.
+
+#ifdef ARDUINO
+
+  #include <Arduino.h>
+  #include <SPI.h>
+  #include <Wire.h>
+  #include <Preferences.h>
+  #include <FS.h>
+  #include <SPIFFS.h>
+  #include <Adafruit_GFX.h>
+  #include <Adafruit_SSD1306.h>
+  #include <RCSwitch.h>
+  #include <AceButton.h>
+  #include <esp_now.h>
+  #include <esp_sleep.h>
+  #include <driver/gpio.h>
+
+  // Includes needed for OTA Updates (Over-The-Air updates)
+  #include <WiFi.h>
+  #include <AsyncTCP.h>
+  #include <ESPAsyncWebServer.h>
+  #include <AsyncElegantOTA.h>
+
+  // Background services: a function called over and over from its own FreeRTOS task,
+  // which sleeps idleMs whenever the function returns false (nothing done), or until
+  // woken up by wakeBackgroundService().
+  // Used for work that blocks (433Mhz transmissions...) and must not stall loop().
+  typedef bool (*BackgroundService)();
+  struct BackgroundServiceConfig {
+    BackgroundService service;
+    uint32_t idleMs;
+    TaskHandle_t task;
+  };
+  const int MAX_BACKGROUND_SERVICES = 8;
+  inline BackgroundServiceConfig **backgroundServices() {
+    static BackgroundServiceConfig *services[MAX_BACKGROUND_SERVICES] = {};
+    return services;
+  }
+  inline void backgroundServiceTask(void *param) {
+    BackgroundServiceConfig *config = (BackgroundServiceConfig *)param;
+    for (;;) {
+      if (!config->service()) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(config->idleMs));
+    }
+  }
+  inline bool startBackgroundService(const char *name, BackgroundService service, uint32_t idleMs,
+                                     uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
+    BackgroundServiceConfig *config = new BackgroundServiceConfig{service, idleMs, NULL};  // Lives as long as the task (forever)
+    for (int i = 0; i < MAX_BACKGROUND_SERVICES; i++) {
+      if (!backgroundServices()[i]) {
+        backgroundServices()[i] = config;
+        break;
+      }
+    }
+    return xTaskCreatePinnedToCore(backgroundServiceTask, name, stackSize, config, priority, &config->task, core) == pdPASS;
+  }
+  // There is work for the service: no need to wait for the end of its idle time
+  inline void wakeBackgroundService(BackgroundService service) {
+    for (int i = 0; i < MAX_BACKGROUND_SERVICES; i++) {
+      BackgroundServiceConfig *config = backgroundServices()[i];
+      if (config && config->service == service && config->task) xTaskNotifyGive(config->task);
+    }
+  }
+  // Stack never used so far by the service's task (bytes), 0 if unknown
+  inline uint32_t backgroundServiceStackFree(BackgroundService service) {
+    for (int i = 0; i < MAX_BACKGROUND_SERVICES; i++) {
+      BackgroundServiceConfig *config = backgroundServices()[i];
+      if (config && config->service == service && config->task) return uxTaskGetStackHighWaterMark(config->task);
+    }
+    return 0;
+  }
+
+  // Idle: loop() sleeps until woken up by wakeLoop() / wakeLoopFromISR() or for at
+  // most maxMs. The core is free meanwhile (FreeRTOS idle task, light sleep if enabled).
+  inline TaskHandle_t &loopTaskHandle() {
+    static TaskHandle_t handle = NULL;
+    return handle;
+  }
+  inline void idleWait(uint32_t maxMs) {
+    if (!loopTaskHandle()) loopTaskHandle() = xTaskGetCurrentTaskHandle();
+    ulTaskNotifyTake(pdTRUE, maxMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(maxMs));
+  }
+  inline void wakeLoop() {
+    if (loopTaskHandle()) xTaskNotifyGive(loopTaskHandle());
+  }
+  // Stack never used so far by loop() (bytes), 0 before its first idleWait()
+  inline uint32_t loopStackFree() {
+    return loopTaskHandle() ? uxTaskGetStackHighWaterMark(loopTaskHandle()) : 0;
+  }
+  inline void IRAM_ATTR wakeLoopFromISR() {
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    if (loopTaskHandle()) vTaskNotifyGiveFromISR(loopTaskHandle(), &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken) portYIELD_FROM_ISR();
+  }
+
+  // Light sleep: the whole chip sleeps for at most maxMs, or until one of wakePins is
+  // pulled LOW (buttons, attached with attachInterrupt(CHANGE)). The radio is off
+  // meanwhile: no WiFi, no ESP-NOW. Returns true when woken up by a pin (its edge
+  // happened while asleep, so no interrupt fired for it).
+  inline bool lightSleep(uint32_t maxMs, const uint8_t *wakePins, size_t count) {
+    for (size_t i = 0; i < count; i++) gpio_wakeup_enable((gpio_num_t)wakePins[i], GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup((uint64_t)maxMs * 1000);
+    esp_light_sleep_start();
+    for (size_t i = 0; i < count; i++) {
+      gpio_wakeup_disable((gpio_num_t)wakePins[i]);
+      gpio_set_intr_type((gpio_num_t)wakePins[i], GPIO_INTR_ANYEDGE);   // Back to CHANGE
+    }
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO;
+  }
+
+#else
+
+  #include "hal_native.h"
+
+#endif
@@ -0,0 +1,713 @@
+#pragma once
+
+// NATIVE (HOST) HAL
+// -----------------
+// Minimal simulated versions of the Arduino / ESP32 APIs used by main.cpp
+// so the controller can be compiled and run on Linux (env:native).
+// Only what the firmware actually uses is provided here, keep it that way.
+//
+// Everything runs on a SIMULATED clock: millis() only moves when the
+// simulator (or a blocking call such as delay(), a radio transmission,
+// an I2C display refresh or a Serial print) advances it. This is what
+// lets the simulator run thousands of times faster than real time while
+// still showing how long the real hardware would have been blocked.
+//
+// The sim:: namespace holds the simulator controls and counters.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <algorithm>
+
+// ============================================================
+// SIMULATION CONTROLS
+// ============================================================
+typedef void (*esp_now_recv_cb_t)(const uint8_t *mac, const uint8_t *data, int len);
+
+namespace sim {
+  extern uint64_t nowUs;                    // Simulated time since boot (microseconds)
+  inline void advanceUs(uint64_t us) { nowUs += us; }
+  inline void advanceMs(uint64_t ms) { nowUs += ms * 1000; }
+
+  // Console
+  extern bool serialEcho;                   // Print Serial output to stdout (default: muted)
+  extern uint64_t serialBytes;              // Bytes written to Serial
+  // GPIO
+  extern uint8_t pinLevels[40];
+  extern uint64_t gpioWrites;
+  // 433Mhz Radio
+  extern uint64_t rfFramesSent;             // Calls to RCSwitch::send()
+  extern unsigned long rfLastCodeSent;
+  void rfInject(unsigned long code);        // Simulate a received 433Mhz code
+  // NVS
+  extern uint64_t nvsWrites;                // Successful Preferences put*() calls
+  // Flash file system (SPIFFS)
+  extern uint64_t flashWrites;              // File write() calls
+  extern uint64_t flashBytesWritten;
+  extern uint64_t flashBytesRead;
+  extern uint64_t flashErasedBytes;         // Files removed (blocks to erase)
+  extern uint64_t flashBusyUs;              // Writes / erases: the flash cache is off, both cores stall
+  // OLED Display (I2C)
+  extern uint64_t i2cBytes;                 // Bytes pushed to the display over I2C
+  extern uint64_t displayRefreshes;         // Calls to display()
+  // WebSocket
+  extern uint64_t wsMessages;               // Messages sent (one per client)
+  extern uint64_t wsBytes;                  // Payload bytes sent (all clients)
+  // ESP-NOW
+  extern esp_now_recv_cb_t espNowRecvCb;
+  void espNowDeliver(const void *data, int len);
+  // Buttons
+  void clickButton(uint8_t pin);            // Simulate a button click (delivered on next check())
+  // ESP
+  extern bool restartRequested;
+
+  // Idle time requested by loop() (idleWait / lightSleep), consumed by the simulator
+  extern uint64_t idleRequestedUs;
+  extern bool lightSleepRequested;
+  extern bool oledOn;                       // SSD1306_DISPLAYON / SSD1306_DISPLAYOFF
+
+  // Background services (see startBackgroundService), run by the simulator
+  // "in parallel" of loop(): the time they spend blocked does not stall loop(),
+  // unless they run on loop()'s core with a higher priority (loop() waits for them)
+  // or write / erase the flash (no flash cache, loop() can't run either).
+  // Returns that time (microseconds)
+  const int LOOP_CORE = 1;                  // Arduino loopTask: core 1, priority 1
+  const unsigned LOOP_PRIORITY = 1;
+  uint64_t runBackgroundServices();
+  template <typename F> void runInBackground(F fn) {
+    uint64_t frozen = nowUs;
+    fn();
+    nowUs = frozen;
+  }
+
+  // Blocking costs of the real hardware (microseconds), used to advance the clock
+  const uint32_t SERIAL_US_PER_BYTE = 87;   // 115200 bauds, 10 bits per byte
+  const uint32_t I2C_US_PER_BYTE    = 23;   // 400Khz, 9 bits per byte
+  const uint32_t NVS_US_PER_WRITE   = 4000; // Typical NVS entry write + commit
+  const uint32_t FLASH_US_PER_WRITE = 1500; // SPIFFS append: metadata update...
+  const uint32_t FLASH_US_PER_KB    = 3000; // ...plus page programming (~3us/byte)
+  const uint32_t FLASH_US_PER_READ  = 200;  // SPIFFS read call (cached pages)
+  const uint32_t FLASH_US_PER_ERASE = 45000;// 4KB sector erase
+  const size_t TCP_SEGMENT_BYTES    = 1436; // Chunked responses are pulled one TCP segment (MSS) at a time
+}
+
+// ============================================================
+// ARDUINO CORE: Clock, GPIO, misc
+// ============================================================
+#define HIGH          0x1
+#define LOW           0x0
+#define INPUT         0x01
+#define OUTPUT        0x03
+#define INPUT_PULLUP  0x05
+#define LED_BUILTIN   2
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define sprintf_P sprintf
+
+// newlib (ESP32) has strlcpy, glibc only since 2.38
+#if !defined(__GLIBC__) || !__GLIBC_PREREQ(2, 38)
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size > 0) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+inline unsigned long millis() { return (uint32_t)(sim::nowUs / 1000); }   // 32 bits, like the ESP32 (roll-over included)
+inline unsigned long micros() { return (uint32_t)sim::nowUs; }
+inline void delay(uint32_t ms) { sim::advanceMs(ms); }
+inline void delayMicroseconds(uint32_t us) { sim::advanceUs(us); }
+
+#define RISING    0x01
+#define FALLING   0x02
+#define CHANGE    0x03
+#define IRAM_ATTR
+inline uint8_t digitalPinToInterrupt(uint8_t pin) { return pin; }
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);     // sim::clickButton() fires it
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void digitalWrite(uint8_t pin, uint8_t val) { sim::pinLevels[pin % 40] = val ? HIGH : LOW; sim::gpioWrites++; }
+inline int digitalRead(uint8_t pin) { return sim::pinLevels[pin % 40]; }
+
+// ============================================================
+// FREERTOS
+// ============================================================
+// No real tasks in the simulator: critical sections are no-ops and
+// background services are polled by the simulator between loop() calls.
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+typedef bool (*BackgroundService)();
+bool startBackgroundService(const char *name, BackgroundService service, uint32_t idleMs,
+                            uint32_t stackSize, unsigned priority, int core);
+inline void wakeBackgroundService(BackgroundService service) {}   // Services run after every loop() anyway
+// No stack to measure on the host: the whole stack given to the task is reported free
+uint32_t backgroundServiceStackFree(BackgroundService service);
+inline uint32_t loopStackFree() { return 8192; }                     // Arduino loop task stack
+
+// loop() idling: the simulator jumps the clock forward (up to the next simulated
+// event) instead of calling loop() again, and counts that time as idle
+inline void idleWait(uint32_t maxMs) { sim::idleRequestedUs = maxMs == UINT32_MAX ? UINT64_MAX : (uint64_t)maxMs * 1000; }
+inline void wakeLoop() { sim::idleRequestedUs = 0; }
+inline void wakeLoopFromISR() { sim::idleRequestedUs = 0; }
+// Same as idleWait() but the radio is off: the simulator drops the ESP-NOW packets
+// sent meanwhile, button clicks still wake it up (their interrupt fires)
+inline bool lightSleep(uint32_t maxMs, const uint8_t *wakePins, size_t count) {
+  idleWait(maxMs);
+  sim::lightSleepRequested = true;
+  return false;
+}
+
+// ============================================================
+// ARDUINO CORE: String, Print
+// ============================================================
+class String {
+  public:
+    String(const char *s = "") : s_(s ? s : "") {}
+    String(const std::string &s) : s_(s) {}
+    explicit String(char c) : s_(1, c) {}
+    explicit String(unsigned char v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(int v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(unsigned int v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(long v, unsigned char base = 10) { fromInt(v, base); }
+    explicit String(unsigned long v, unsigned char base = 10) { fromInt((long long)v, base); }
+    explicit String(float v, unsigned int decimals = 2) { fromFloat(v, decimals); }
+    explicit String(double v, unsigned int decimals = 2) { fromFloat(v, decimals); }
+
+    const char *c_str() const { return s_.c_str(); }
+    unsigned int length() const { return s_.length(); }
+    bool reserve(unsigned int size) { s_.reserve(size); return true; }
+    long toInt() const { return atol(s_.c_str()); }
+    float toFloat() const { return atof(s_.c_str()); }
+
+    String &operator+=(const String &rhs) { s_ += rhs.s_; return *this; }
+    String &operator+=(const char *rhs) { s_ += rhs; return *this; }
+    String &operator+=(char c) { s_ += c; return *this; }
+    friend String operator+(const String &lhs, const String &rhs) { return String(lhs.s_ + rhs.s_); }
+    friend String operator+(const String &lhs, const char *rhs) { return String(lhs.s_ + rhs); }
+    friend String operator+(const char *lhs, const String &rhs) { return String(lhs + rhs.s_); }
+    bool operator==(const String &rhs) const { return s_ == rhs.s_; }
+    bool operator==(const char *rhs) const { return s_ == rhs; }
+    bool operator!=(const String &rhs) const { return s_ != rhs.s_; }
+    bool operator!=(const char *rhs) const { return s_ != rhs; }
+    bool operator<(const String &rhs) const { return s_ < rhs.s_; }
+
+  private:
+    void fromInt(long long v, unsigned char base) {
+      char b[24];
+      snprintf(b, sizeof(b), base == 16 ? "%llx" : "%lld", v);
+      s_ = b;
+    }
+    void fromFloat(double v, unsigned int decimals) {
+      char b[48];
+      snprintf(b, sizeof(b), "%.*f", (int)decimals, v);
+      s_ = b;
+    }
+    std::string s_;
+};
+
+class Print;
+class Printable {
+  public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+    size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t write(uint8_t c) { return write(&c, 1); }
+
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s) { return write(s.c_str()); }
+    size_t print(char c) { return write((const uint8_t *)&c, 1); }
+    size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) { return printFormat(base == HEX ? "%lX" : "%ld", v); }
+    size_t print(unsigned long v, int base = DEC) { return printFormat(base == HEX ? "%lX" : "%lu", v); }
+    size_t print(double v, int digits = 2) { return printFormat("%.*f", digits, v); }
+    size_t print(const Printable &p) { return p.printTo(*this); }
+
+    template <typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(const T &v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+      char buff[256];
+      va_list args;
+      va_start(args, format);
+      int len = vsnprintf(buff, sizeof(buff), format, args);
+      va_end(args);
+      if (len < 0) return 0;
+      return write((const uint8_t *)buff, (size_t)len < sizeof(buff) ? len : sizeof(buff) - 1);
+    }
+
+  private:
+    template <typename... Args> size_t printFormat(const char *format, Args... args) {
+      char buff[48];
+      int len = snprintf(buff, sizeof(buff), format, args...);
+      return len > 0 ? write((const uint8_t *)buff, len) : 0;
+    }
+};
+
+// Serial console: blocks for the time needed to push the bytes out at 115200 bauds
+class HardwareSerial : public Print {
+  public:
+    void begin(unsigned long baud) {}
+    using Print::write;
+    size_t write(const uint8_t *buffer, size_t size) override {
+      sim::serialBytes += size;
+      sim::advanceUs((uint64_t)size * sim::SERIAL_US_PER_BYTE);
+      if (sim::serialEcho) fwrite(buffer, 1, size, stdout);
+      return size;
+    }
+};
+extern HardwareSerial Serial;
+
+// ============================================================
+// ESP32 SYSTEM
+// ============================================================
+class EspClass {
+  public:
+    void restart() { sim::restartRequested = true; }
+    uint32_t getFreeHeap() { return 200000; }
+    uint32_t getMinFreeHeap() { return 200000; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getCycleCount() { return (uint32_t)(sim::nowUs * 240); }   // Simulated time: only the blocking costs show
+};
+extern EspClass ESP;
+
+// ============================================================
+// WIFI
+// ============================================================
+class IPAddress : public Printable {
+  public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : b_{a, b, c, d} {}
+    String toString() const {
+      char buff[16];
+      snprintf(buff, sizeof(buff), "%u.%u.%u.%u", b_[0], b_[1], b_[2], b_[3]);
+      return String(buff);
+    }
+    size_t printTo(Print &p) const override { return p.print(toString()); }
+  private:
+    uint8_t b_[4];
+};
+
+#define WL_CONNECTED 3
+#define WIFI_STA 1
+class WiFiClass {
+  public:
+    bool softAP(const char *ssid, const char *passphrase = nullptr) { return true; }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    IPAddress localIP() { return IPAddress(192, 168, 1, 50); }
+    int32_t channel() { return 1; }
+    String macAddress() { return String("24:0A:C4:00:00:01"); }
+    String softAPmacAddress() { return String("24:0A:C4:00:00:02"); }
+    bool mode(int m) { return true; }
+    int begin(const char *ssid, const char *passphrase = nullptr) { return WL_CONNECTED; }
+    int status() { return WL_CONNECTED; }
+};
+extern WiFiClass WiFi;
+
+// ============================================================
+// ESP-NOW
+// ============================================================
+typedef int esp_err_t;
+#define ESP_OK 0
+inline esp_err_t esp_now_init() { return ESP_OK; }
+inline esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb) { sim::espNowRecvCb = cb; return ESP_OK; }
+
+// ============================================================
+// NVS (Preferences)
+// ============================================================
+class Preferences {
+  public:
+    bool begin(const char *name, bool readOnly = false) { ns_ = name; return true; }
+    void end() {}
+    size_t putInt(const char *key, int32_t value) { return putBytes(key, &value, sizeof(value)); }
+    int32_t getInt(const char *key, int32_t defaultValue = 0) {
+      int32_t v = defaultValue;
+      return getBytes(key, &v, sizeof(v)) == sizeof(v) ? v : defaultValue;
+    }
+    size_t putString(const char *key, const char *value) { return putBytes(key, value, strlen(value) + 1) ? strlen(value) : 0; }
+    size_t putString(const char *key, const String &value) { return putString(key, value.c_str()); }
+    String getString(const char *key, String defaultValue = String()) {
+      auto it = store().find(ns_ + "/" + key);
+      if (it == store().end()) return defaultValue;
+      return String((const char *)it->second.data());
+    }
+    size_t putBytes(const char *key, const void *value, size_t len) {
+      const uint8_t *p = (const uint8_t *)value;
+      store()[ns_ + "/" + key].assign(p, p + len);
+      sim::nvsWrites++;
+      sim::advanceUs(sim::NVS_US_PER_WRITE);
+      return len;
+    }
+    bool remove(const char *key) {
+      sim::nvsWrites++;
+      sim::advanceUs(sim::NVS_US_PER_WRITE);
+      return store().erase(ns_ + "/" + key) > 0;
+    }
+    size_t getBytes(const char *key, void *buf, size_t maxLen) {
+      auto it = store().find(ns_ + "/" + key);
+      if (it == store().end() || it->second.size() > maxLen) return 0;
+      memcpy(buf, it->second.data(), it->second.size());
+      return it->second.size();
+    }
+  private:
+    static std::map<std::string, std::vector<uint8_t>> &store();   // Survives a simulated reboot
+    std::string ns_;
+};
+
+// ============================================================
+// FLASH FILE SYSTEM (FS / SPIFFS)
+// ============================================================
+// Files are kept in memory for the whole run (they survive a simulated reboot).
+// Writes, reads and removals advance the clock by what SPIFFS would take.
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+class File {
+  public:
+    File() {}
+    File(std::vector<uint8_t> *data, const char *mode) : data_(data), position_(mode[0] == 'a' ? data->size() : 0) {}
+    explicit operator bool() const { return data_ != nullptr; }
+    size_t write(const uint8_t *buf, size_t len);
+    size_t read(uint8_t *buf, size_t len);
+    bool seek(uint32_t pos) {
+      if (!data_ || pos > data_->size()) return false;
+      position_ = pos;
+      return true;
+    }
+    size_t position() const { return position_; }
+    size_t size() const { return data_ ? data_->size() : 0; }
+    void close() { data_ = nullptr; }
+  private:
+    std::vector<uint8_t> *data_ = nullptr;
+    size_t position_ = 0;
+};
+
+class SPIFFSFS {
+  public:
+    bool begin(bool formatOnFail = false) { return true; }
+    size_t totalBytes() const { return 1378241; }   // Default partition table (0x160000), minus SPIFFS overhead
+    size_t usedBytes() const;
+    bool exists(const char *path) const { return files().count(path) > 0; }
+    bool remove(const char *path);
+    File open(const char *path, const char *mode = FILE_READ);
+  private:
+    static std::map<std::string, std::vector<uint8_t>> &files();
+};
+extern SPIFFSFS SPIFFS;
+
+// ============================================================
+// OLED DISPLAY (Adafruit_SSD1306 over I2C)
+// ============================================================
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_SWITCHCAPVCC 0x02
+#define SSD1306_DISPLAYOFF 0xAE
+#define SSD1306_DISPLAYON 0xAF
+// I2C: every byte on the bus (address byte included) costs I2C_US_PER_BYTE
+class TwoWire {
+  public:
+    void beginTransmission(uint8_t address) { pending_ = 1; }
+    size_t write(uint8_t data) { pending_++; return 1; }
+    size_t write(const uint8_t *data, size_t len) { pending_ += len; return len; }
+    uint8_t endTransmission(bool sendStop = true) {
+      sim::i2cBytes += pending_;
+      sim::advanceUs(pending_ * sim::I2C_US_PER_BYTE);
+      pending_ = 0;
+      return 0;
+    }
+  private:
+    size_t pending_ = 0;
+};
+extern TwoWire Wire;
+
+// Text is rendered into the framebuffer with a fake 5x7 font (one made-up glyph per
+// character), so what is drawn and what changes between two frames is realistic.
+class Adafruit_SSD1306 : public Print {
+  public:
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi, int8_t rst_pin = -1) : width_(w), height_(h), buffer_(w * ((h + 7) / 8), 0) {}
+    bool begin(uint8_t switchvcc, uint8_t i2caddr) { return true; }
+    int16_t width() const { return width_; }
+    int16_t height() const { return height_; }
+    void clearDisplay() { std::fill(buffer_.begin(), buffer_.end(), 0); }
+    void ssd1306_command(uint8_t c) {
+      if (c == SSD1306_DISPLAYOFF) sim::oledOn = false;
+      if (c == SSD1306_DISPLAYON) sim::oledOn = true;
+      sim::i2cBytes += 3;
+      sim::advanceUs(3 * sim::I2C_US_PER_BYTE);
+    }
+    void setTextSize(uint8_t s) { textSize_ = s; }
+    void setTextColor(uint16_t c) { textColor_ = c; textBgColor_ = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textColor_ = c; textBgColor_ = bg; }
+    void setCursor(int16_t x, int16_t y) { cursorX_ = x; cursorY_ = y; }
+    uint8_t *getBuffer() { return buffer_.data(); }
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+      if (x < 0 || y < 0 || x >= width_ || y >= height_) return;
+      uint8_t &cell = buffer_[x + (y / 8) * width_];
+      if (color) cell |= (1 << (y & 7));
+      else cell &= ~(1 << (y & 7));
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+      for (int16_t i = x; i < x + w; i++)
+        for (int16_t j = y; j < y + h; j++) drawPixel(i, j, color);
+    }
+    // Full frame refresh: the whole framebuffer goes over I2C (plus addressing commands)
+    void display() {
+      size_t bytes = buffer_.size() + 8;
+      sim::i2cBytes += bytes;
+      sim::displayRefreshes++;
+      sim::advanceUs(bytes * sim::I2C_US_PER_BYTE);
+    }
+    using Print::write;
+    size_t write(const uint8_t *buffer, size_t size) override {
+      for (size_t i = 0; i < size; i++) {
+        if (buffer[i] == '\n') { cursorX_ = 0; cursorY_ += 8 * textSize_; }
+        else if (buffer[i] != '\r') { drawChar(buffer[i]); cursorX_ += 6 * textSize_; }
+      }
+      return size;
+    }
+  private:
+    void drawChar(uint8_t c) {
+      for (int col = 0; col < 6; col++) {
+        uint8_t bits = (col == 5 || c <= ' ') ? 0 : (uint8_t)(((c * 37 + col * 11) ^ (c >> 1)) | 0x01) & 0x7F;
+        for (int row = 0; row < 8; row++) {
+          bool on = bits & (1 << row);
+          if (!on && textBgColor_ == textColor_) continue;   // Transparent background
+          fillRect(cursorX_ + col * textSize_, cursorY_ + row * textSize_, textSize_, textSize_, on ? textColor_ : textBgColor_);
+        }
+      }
+    }
+    uint8_t width_, height_;
+    std::vector<uint8_t> buffer_;
+    uint8_t textSize_ = 1;
+    uint16_t textColor_ = SSD1306_WHITE, textBgColor_ = SSD1306_WHITE;
+    int16_t cursorX_ = 0, cursorY_ = 0;
+};
+
+// ============================================================
+// 433Mhz RADIO (RCSwitch)
+// ============================================================
+class RCSwitch {
+  public:
+    void enableReceive(int interrupt) {}
+    void disableReceive() {}
+    void enableTransmit(int pin) {}
+    void setProtocol(int protocol) {}
+    void setPulseLength(int len) { pulseLength_ = len; }
+    void setRepeatTransmit(int n) { repeat_ = n; }
+    // Blocking like the real one: protocol 1 uses 4 pulses per bit plus a 32 pulses sync, repeated N times
+    void send(unsigned long code, unsigned int length) {
+      sim::rfFramesSent++;
+      sim::rfLastCodeSent = code;
+      sim::advanceUs((uint64_t)(length * 4 + 32) * pulseLength_ * repeat_);
+    }
+    bool available();
+    void resetAvailable();
+    unsigned long getReceivedValue();
+    unsigned int getReceivedBitlength() { return 24; }
+    unsigned int getReceivedDelay() { return 325; }
+    unsigned int getReceivedProtocol() { return 1; }
+    unsigned int *getReceivedRawdata() { static unsigned int raw[67] = {0}; return raw; }
+  private:
+    int pulseLength_ = 350;
+    int repeat_ = 10;
+};
+
+// ============================================================
+// BUTTONS (AceButton)
+// ============================================================
+namespace ace_button {
+  class AceButton;
+  class ButtonConfig {
+    public:
+      typedef void (*EventHandler)(AceButton *button, uint8_t eventType, uint8_t buttonState);
+      static const uint16_t kFeatureClick = 0x01;
+      static const uint16_t kFeatureDoubleClick = 0x02;
+      static const uint16_t kFeatureLongPress = 0x04;
+      static ButtonConfig *getSystemButtonConfig();
+      void setEventHandler(EventHandler handler) { handler_ = handler; }
+      void setFeature(uint16_t features) { features_ |= features; }
+      EventHandler getEventHandler() { return handler_; }
+    private:
+      EventHandler handler_ = nullptr;
+      uint16_t features_ = 0;
+  };
+
+  class AceButton {
+    public:
+      static const uint8_t kEventPressed = 0;
+      static const uint8_t kEventReleased = 1;
+      static const uint8_t kEventClicked = 2;
+      static const uint8_t kEventDoubleClicked = 3;
+      static const uint8_t kEventLongPressed = 4;
+      explicit AceButton(uint8_t pin = 0, uint8_t defaultReleasedState = HIGH, uint8_t id = 0);
+      uint8_t getPin() const { return pin_; }
+      uint8_t getId() const { return id_; }
+      void check();
+    private:
+      friend void sim::clickButton(uint8_t pin);
+      uint8_t pin_, id_;
+      uint8_t pendingClicks_ = 0;
+  };
+}
+
+// ============================================================
+// ASYNC WEB SERVER & WEBSOCKET
+// ============================================================
+typedef enum {
+  HTTP_GET = 0b00000001,
+  HTTP_POST = 0b00000010,
+  HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+typedef std::function<String(const String &)> AwsTemplateProcessor;
+// Chunked responses: called whenever the connection can take more data, returns the bytes
+// written in buffer (0: the response is complete)
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+class AsyncWebParameter {
+  public:
+    AsyncWebParameter(const String &name, const String &value) : name_(name), value_(value) {}
+    const String &name() const { return name_; }
+    const String &value() const { return value_; }
+  private:
+    String name_, value_;
+};
+
+class AsyncWebServerResponse {
+  public:
+    AsyncWebServerResponse(int code, const char *contentType, const uint8_t *content, size_t len)
+      : code_(code), body_((const char *)content, len) {}
+    AsyncWebServerResponse(int code, const char *contentType, AwsResponseFiller filler) : code_(code), filler_(filler) {}
+    void addHeader(const String &name, const String &value) { headers_.emplace_back(name.c_str(), value.c_str()); }
+  private:
+    friend class AsyncWebServerRequest;
+    int code_;
+    std::string body_;
+    AwsResponseFiller filler_;
+    std::vector<std::pair<std::string, std::string>> headers_;
+};
+
+class AsyncWebServerRequest {
+  public:
+    AsyncWebServerRequest(const std::map<std::string, std::string> &params, const std::map<std::string, std::string> &headers);
+    bool hasParam(const char *name) const;
+    AsyncWebParameter *getParam(const char *name);
+    bool hasHeader(const char *name) const;
+    const String &header(const char *name) const;
+    void send(int code, const char *contentType = "", const String &content = String());
+    void send_P(int code, const char *contentType, const char *content, AwsTemplateProcessor callback = nullptr);
+    AsyncWebServerResponse *beginResponse_P(int code, const char *contentType, const uint8_t *content, size_t len) {
+      return new AsyncWebServerResponse(code, contentType, content, len);
+    }
+    AsyncWebServerResponse *beginChunkedResponse(const String &contentType, AwsResponseFiller filler,
+                                                 AwsTemplateProcessor callback = nullptr) {
+      return new AsyncWebServerResponse(200, contentType.c_str(), filler);
+    }
+    void send(AsyncWebServerResponse *response);
+    void redirect(const char *url);
+    // Simulator side: what has been answered
+    int responseCode = 0;
+    std::string responseBody;
+    size_t responseChunks = 0;                // Chunked responses: filler calls (one TCP segment each)
+    std::map<std::string, std::string> responseHeaders;
+  private:
+    std::vector<AsyncWebParameter> params_;
+    std::vector<AsyncWebParameter> headers_;
+};
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+
+class AsyncWebHandler {
+  public:
+    virtual ~AsyncWebHandler() {}
+};
+
+class AsyncWebServer {
+  public:
+    explicit AsyncWebServer(uint16_t port) {}
+    void on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) { routes_[uri] = onRequest; }
+    void addHandler(AsyncWebHandler *handler) {}
+    void begin() {}
+    // Simulator side: run a GET request through the registered handler
+    bool simulateGet(const char *uri, const std::map<std::string, std::string> &params, AsyncWebServerRequest **answered = nullptr,
+                     const std::map<std::string, std::string> &headers = {});
+  private:
+    std::map<std::string, ArRequestHandlerFunction> routes_;
+};
+
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+#define WS_CONTINUATION 0x00
+#define WS_TEXT         0x01
+#define WS_BINARY       0x02
+typedef struct {
+  uint8_t message_opcode;
+  uint32_t num;
+  uint8_t final;
+  uint8_t masked;
+  uint8_t opcode;
+  uint64_t len;
+  uint8_t mask[4];
+  uint64_t index;
+} AwsFrameInfo;
+
+class AsyncWebSocket;
+class AsyncWebSocketClient {
+  public:
+    explicit AsyncWebSocketClient(uint32_t id) : id_(id) {}
+    uint32_t id() const { return id_; }
+    IPAddress remoteIP() const { return IPAddress(192, 168, 4, 2 + id_); }
+  private:
+    uint32_t id_;
+};
+typedef std::function<void(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler {
+  public:
+    explicit AsyncWebSocket(const String &url) {}
+    void onEvent(AwsEventHandler handler) { handler_ = handler; }
+    size_t count() const { return clients_.size(); }
+    void cleanupClients(uint16_t maxClients = 8) {}
+    void textAll(const char *message, size_t len) {
+      sim::wsMessages += clients_.size();
+      sim::wsBytes += len * clients_.size();
+      lastMessage.assign(message, len);
+    }
+    void textAll(const String &message) { textAll(message.c_str(), message.length()); }
+    // Simulator side: browsers connecting / leaving, last payload sent
+    void simulateConnect();
+    void simulateDisconnect();
+    std::string lastMessage;
+  private:
+    AwsEventHandler handler_;
+    std::vector<AsyncWebSocketClient> clients_;
+    uint32_t nextId_ = 1;
+};
+
+class AsyncElegantOtaClass {
+  public:
+    void begin(AsyncWebServer *server, const char *username = "", const char *password = "") {}
+};
+extern AsyncElegantOtaClass AsyncElegantOTA;
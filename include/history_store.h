@@ -0,0 +1,390 @@
+#pragma once
+
+// HISTORY STORE
+// -------------
+// Months of water level and pump history kept on the SPIFFS partition, in 3 tiers:
+//   HISTORY_MINUTES : one record per minute            (about 4 weeks)
+//   HISTORY_HOURS   : hourly rollups of the minutes    (about 9 months)
+//   HISTORY_DAYS    : daily rollups of the hours       (years)
+//
+// - Every record is the same fixed size binary struct (min / mean / max distance,
+//   share of valid measures, duty of each pump), no text, no parsing.
+// - Each tier is a ring of HISTORY_SEGMENTS append-only files sized from the
+//   partition: when the current segment is full the oldest one is removed and
+//   started again. Nothing is ever rewritten in place.
+// - loop() only adds samples (sample(), RAM only). Records are batched in RAM pages
+//   and the full pages are written by a background service (flush()), so loop()
+//   never waits for SPIFFS itself. It still stalls while the flash is being written
+//   or erased: the flash cache is off on both cores meanwhile. Segments are kept
+//   small so that removing one (erasing its sectors) is a short burst.
+//
+//   HistoryStore history;
+//   history.begin();                          // setup(): sizes the tiers, finds where we were
+//   history.sample(distanceCm, pumpsMask);    // Every tick
+//   history.setFlushService(flushHistory);   // bool flushHistory() { return history.flush(); }
+//   startBackgroundService("history", flushHistory, ...);
+//
+// There is no RTC: the history clock (seconds) carries on from the last record
+// after a reboot, the time the controller was off is not counted. A power cut
+// loses the records still in RAM (at most one page of minutes).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <math.h>
+#include "hal.h"
+#include "spsc_queue.h"
+
+#define HISTORY_MAX_PUMPS       8
+#define HISTORY_SEGMENTS        64      // Files per tier: a minutes segment is ~13KB, 4 sectors to erase
+#define HISTORY_PARTITION_SHARE 75      // % of the SPIFFS partition used (SPIFFS needs free blocks for its GC)
+#define HISTORY_RATIO_SCALE     250     // Ratios (valid, duty) are stored as 0..250 = 0..100%
+
+enum HistoryTier : uint8_t { HISTORY_MINUTES, HISTORY_HOURS, HISTORY_DAYS, HISTORY_TIERS };
+
+struct HistoryRecord {
+  uint32_t time;                        // Start of the period (history clock, seconds)
+  int16_t distanceMinMm;                // Filtered sensor-to-water distance over the period
+  int16_t distanceMeanMm;
+  int16_t distanceMaxMm;
+  uint8_t valid;                        // Share of the period with a valid measure (HISTORY_RATIO_SCALE)
+  uint8_t reserved;
+  uint8_t pumpDuty[HISTORY_MAX_PUMPS];  // Share of the period each pump ran (HISTORY_RATIO_SCALE)
+};
+static_assert(sizeof(HistoryRecord) == 20, "HistoryRecord: the file format is 20 bytes per record");
+
+class HistoryStore {
+  public:
+    // Where a reader is: segment (0 = oldest, HISTORY_SEGMENTS = RAM page), record index in it
+    struct Cursor {
+      HistoryTier tier;
+      uint8_t step;
+      uint32_t index;
+    };
+
+    // setup(): sizes the tiers from the partition, finds the newest segment of each tier
+    bool begin() {
+      if (!SPIFFS.begin(true)) return false;
+      size_t budget = SPIFFS.totalBytes() / 100 * HISTORY_PARTITION_SHARE;
+      uint32_t clock = 0;
+      for (int t = 0; t < HISTORY_TIERS; t++) {
+        TierState &tier = tiers_[t];
+        tier.segmentRecords = budget / 100 * tierConfigs[t].budgetShare / HISTORY_SEGMENTS / sizeof(HistoryRecord);
+        if (tier.segmentRecords == 0) tier.segmentRecords = 1;
+        uint32_t newestTime = 0;
+        bool found = false;
+        for (uint8_t s = 0; s < HISTORY_SEGMENTS; s++) {
+          HistoryRecord last;
+          uint32_t count = segmentCount((HistoryTier)t, s);
+          if (count == 0 || !readRecord((HistoryTier)t, s, count - 1, last)) continue;
+          if (!found || last.time >= newestTime) {
+            found = true;
+            newestTime = last.time;
+            tier.segment = s;
+            tier.segmentCount = count;
+            // Torn record at the end (power cut while writing): never append after it
+            if (segmentBytes((HistoryTier)t, s) % sizeof(HistoryRecord) != 0) tier.segmentCount = tier.segmentRecords;
+          }
+        }
+        if (found && newestTime + tierConfigs[t].periodSeconds > clock) clock = newestTime + tierConfigs[t].periodSeconds;
+        tier.accumulator.reset(0);
+      }
+      clock_ = clock;
+      lastSampleMs_ = millis();
+      ready_ = true;
+      return true;
+    }
+
+    // The background service calling flush(), woken up when a page is full
+    void setFlushService(BackgroundService service) { flushService_ = service; }
+
+    // loop() side: the state since the previous sample (every tick, or less often)
+    void sample(float distanceCm, uint8_t pumpsPowered) {
+      if (!ready_) return;
+      uint32_t elapsedMs = millis() - lastSampleMs_ + pendingMs_;
+      lastSampleMs_ = millis();
+      uint32_t seconds = elapsedMs / 1000;
+      pendingMs_ = elapsedMs % 1000;
+      if (seconds == 0) return;
+
+      TierState &minutes = tiers_[HISTORY_MINUTES];
+      uint32_t periodStart = clock_ - clock_ % 60;
+      if (minutes.accumulator.seconds == 0) minutes.accumulator.reset(periodStart);
+      minutes.accumulator.addSample(distanceCm, pumpsPowered, seconds);
+      clock_ += seconds;
+      // Period over: the record goes to its page, and rolls up into the next tier
+      for (int t = 0; t < HISTORY_TIERS; t++) {
+        TierState &tier = tiers_[t];
+        uint32_t period = tierConfigs[t].periodSeconds;
+        if (tier.accumulator.seconds == 0 || clock_ / period == tier.accumulator.start / period) break;
+        HistoryRecord record = tier.accumulator.record(period);
+        append((HistoryTier)t, record);
+        if (t + 1 < HISTORY_TIERS) {
+          TierState &next = tiers_[t + 1];
+          uint32_t nextPeriod = tierConfigs[t + 1].periodSeconds;
+          if (next.accumulator.seconds == 0) next.accumulator.reset(record.time - record.time % nextPeriod);
+          next.accumulator.addRecord(record, period);
+        }
+        tier.accumulator.reset(clock_ - clock_ % period);
+      }
+    }
+
+    // Background service: writes the full pages. Returns false when there was nothing to do
+    bool flush() {
+      Page page;
+      if (!fullPages_.pop(page)) return false;
+      write(page);
+      return true;
+    }
+
+    // Before a reboot (any task): the pages not full yet go to the writer too
+    void requestFlush() {
+      for (int t = 0; t < HISTORY_TIERS; t++) handOver((HistoryTier)t);
+    }
+    bool flushPending() const { return !fullPages_.empty(); }
+
+    // Readers (web server...): the first record at or after fromTime
+    Cursor seek(HistoryTier tier, uint32_t fromTime) const {
+      Cursor cursor = { tier, 0, 0 };
+      for (; cursor.step < HISTORY_SEGMENTS; cursor.step++) {
+        uint8_t s = stepSegment(tier, cursor.step);
+        uint32_t count = segmentCount(tier, s);
+        HistoryRecord record;
+        if (count == 0 || !readRecord(tier, s, count - 1, record) || record.time < fromTime) continue;
+        // Records are in time order in a segment: binary search
+        uint32_t low = 0, high = count - 1;
+        while (low < high) {
+          uint32_t middle = (low + high) / 2;
+          if (readRecord(tier, s, middle, record) && record.time >= fromTime) high = middle;
+          else low = middle + 1;
+        }
+        cursor.index = low;
+        return cursor;
+      }
+      return cursor;   // Only the RAM page left
+    }
+
+    // Readers: up to max records from the cursor (oldest first), 0 at the end
+    size_t read(Cursor &cursor, HistoryRecord *records, size_t max) const {
+      while (cursor.step < HISTORY_SEGMENTS) {
+        uint8_t s = stepSegment(cursor.tier, cursor.step);
+        uint32_t count = segmentCount(cursor.tier, s);
+        if (cursor.index < count) {
+          size_t n = count - cursor.index < max ? count - cursor.index : max;
+          n = readRecords(cursor.tier, s, cursor.index, records, n);
+          if (n > 0) {
+            cursor.index += n;
+            return n;
+          }
+        }
+        cursor.step++;
+        cursor.index = 0;
+      }
+      // Then what is still in RAM
+      size_t n = 0;
+      portENTER_CRITICAL(&mux_);
+      const Page &page = tiers_[cursor.tier].page;
+      while (cursor.index < page.count && n < max) records[n++] = page.records[cursor.index++];
+      portEXIT_CRITICAL(&mux_);
+      return n;
+    }
+
+    // Time of the oldest record of the tier (UINT32_MAX when there is none)
+    uint32_t oldestTime(HistoryTier tier) const {
+      Cursor cursor = { tier, 0, 0 };
+      HistoryRecord record;
+      return read(cursor, &record, 1) == 1 ? record.time : UINT32_MAX;
+    }
+
+    uint32_t now() const { return clock_; }
+    uint32_t segmentRecords(HistoryTier tier) const { return tiers_[tier].segmentRecords; }
+    uint32_t capacity(HistoryTier tier) const { return tiers_[tier].segmentRecords * (HISTORY_SEGMENTS - 1); }   // At least
+    uint32_t recordsAdded(HistoryTier tier) const { return tiers_[tier].recordsAdded; }
+    uint32_t pagesWritten() const { return pagesWritten_; }
+    uint32_t pagesDropped() const { return fullPages_.dropped(); }
+    uint32_t writeFailures() const { return writeFailures_; }
+
+    static constexpr uint32_t periodSeconds(HistoryTier tier) { return tierConfigs[tier].periodSeconds; }
+
+  private:
+    struct TierConfig {
+      char prefix;
+      uint32_t periodSeconds;
+      uint8_t budgetShare;            // % of the history budget
+      uint8_t pageRecords;            // Records batched in RAM before a flash write
+    };
+    static constexpr TierConfig tierConfigs[HISTORY_TIERS] = {
+      { 'm', 60, 80, 16 },            // A write every 16 minutes
+      { 'h', 3600, 15, 1 },
+      { 'd', 86400, 5, 1 },
+    };
+    static const uint8_t PAGE_RECORDS = 16;
+
+    struct Page {
+      HistoryTier tier;
+      uint8_t count = 0;
+      HistoryRecord records[PAGE_RECORDS];
+    };
+
+    // Sums over a period: samples (minutes) or records of the tier below (rollups)
+    struct Accumulator {
+      uint32_t start;
+      uint32_t seconds;
+      uint32_t validSeconds;
+      float distanceSum;              // cm x seconds
+      float distanceMin;
+      float distanceMax;
+      uint32_t pumpSeconds[HISTORY_MAX_PUMPS];
+
+      void reset(uint32_t periodStart) {
+        *this = {};
+        start = periodStart;
+      }
+      void addValid(float minCm, float meanCm, float maxCm, uint32_t validFor) {
+        if (validFor == 0) return;
+        if (validSeconds == 0 || minCm < distanceMin) distanceMin = minCm;
+        if (validSeconds == 0 || maxCm > distanceMax) distanceMax = maxCm;
+        validSeconds += validFor;
+        distanceSum += meanCm * validFor;
+      }
+      void addSample(float distanceCm, uint8_t pumpsPowered, uint32_t s) {
+        seconds += s;
+        if (distanceCm > 0) addValid(distanceCm, distanceCm, distanceCm, s);   // 0 (or NaN): no valid measure
+        for (int i = 0; i < HISTORY_MAX_PUMPS; i++)
+          if (pumpsPowered & (1 << i)) pumpSeconds[i] += s;
+      }
+      void addRecord(const HistoryRecord &r, uint32_t period) {
+        seconds += period;
+        addValid(r.distanceMinMm / 10.0f, r.distanceMeanMm / 10.0f, r.distanceMaxMm / 10.0f, ratioSeconds(r.valid, period));
+        for (int i = 0; i < HISTORY_MAX_PUMPS; i++) pumpSeconds[i] += ratioSeconds(r.pumpDuty[i], period);
+      }
+      HistoryRecord record(uint32_t period) const {
+        HistoryRecord r = {};
+        r.time = start;
+        if (validSeconds > 0) {
+          r.distanceMinMm = toMm(distanceMin);
+          r.distanceMeanMm = toMm(distanceSum / validSeconds);
+          r.distanceMaxMm = toMm(distanceMax);
+        }
+        r.valid = ratio(validSeconds, period);
+        for (int i = 0; i < HISTORY_MAX_PUMPS; i++) r.pumpDuty[i] = ratio(pumpSeconds[i], period);
+        return r;
+      }
+      static int16_t toMm(float cm) {
+        float mm = roundf(cm * 10);
+        return mm > INT16_MAX ? INT16_MAX : (mm < INT16_MIN ? INT16_MIN : (int16_t)mm);
+      }
+      static uint8_t ratio(uint32_t part, uint32_t period) {
+        return part >= period ? HISTORY_RATIO_SCALE : (uint8_t)((part * (uint64_t)HISTORY_RATIO_SCALE + period / 2) / period);
+      }
+      static uint32_t ratioSeconds(uint8_t r, uint32_t period) {
+        return (uint64_t)r * period / HISTORY_RATIO_SCALE;
+      }
+    };
+
+    struct TierState {
+      uint32_t segmentRecords = 1;
+      uint8_t segment = 0;            // Being written (writer side)
+      uint32_t segmentCount = 0;      // Records in it
+      uint32_t recordsAdded = 0;
+      Accumulator accumulator;
+      Page page;                      // Filling up (loop() side)
+    };
+
+    void append(HistoryTier tier, const HistoryRecord &record) {
+      TierState &state = tiers_[tier];
+      portENTER_CRITICAL(&mux_);
+      state.page.tier = tier;
+      state.page.records[state.page.count++] = record;
+      portEXIT_CRITICAL(&mux_);
+      state.recordsAdded++;
+      if (state.page.count >= tierConfigs[tier].pageRecords) handOver(tier);
+    }
+
+    // The page goes to the background writer, a new one starts
+    void handOver(HistoryTier tier) {
+      Page &page = tiers_[tier].page;
+      portENTER_CRITICAL(&mux_);
+      bool full = page.count > 0;
+      if (full) fullPages_.push(page);    // Writer too far behind: the page is dropped (and counted)
+      page.count = 0;
+      portEXIT_CRITICAL(&mux_);
+      if (full && flushService_) wakeBackgroundService(flushService_);
+    }
+
+    // Background side: appends the page, moving on to the next segment when the current one is full
+    void write(const Page &page) {
+      TierState &state = tiers_[page.tier];
+      uint8_t written = 0;
+      while (written < page.count) {
+        if (state.segmentCount >= state.segmentRecords) {
+          state.segment = (state.segment + 1) % HISTORY_SEGMENTS;
+          state.segmentCount = 0;
+          char path[24];
+          segmentPath(page.tier, state.segment, path, sizeof(path));
+          SPIFFS.remove(path);        // Oldest data of the tier goes
+        }
+        uint32_t room = state.segmentRecords - state.segmentCount;
+        uint32_t left = (uint32_t)page.count - written;
+        uint32_t n = left < room ? left : room;
+        char path[24];
+        segmentPath(page.tier, state.segment, path, sizeof(path));
+        File file = SPIFFS.open(path, FILE_APPEND);
+        size_t bytes = n * sizeof(HistoryRecord);
+        if (!file || file.write((const uint8_t *)&page.records[written], bytes) != bytes) {
+          writeFailures_++;
+          if (file) file.close();
+          state.segmentCount = state.segmentRecords;   // Don't append after a partial write: next segment
+          return;
+        }
+        file.close();
+        state.segmentCount += n;
+        written += n;
+      }
+      pagesWritten_++;
+    }
+
+    uint8_t stepSegment(HistoryTier tier, uint8_t step) const {
+      return (tiers_[tier].segment + 1 + step) % HISTORY_SEGMENTS;   // Oldest first, the one being written last
+    }
+
+    static void segmentPath(HistoryTier tier, uint8_t segment, char *path, size_t size) {
+      snprintf(path, size, "/history/%c%u.bin", tierConfigs[tier].prefix, (unsigned)segment);
+    }
+    static size_t segmentBytes(HistoryTier tier, uint8_t segment) {
+      char path[24];
+      segmentPath(tier, segment, path, sizeof(path));
+      if (!SPIFFS.exists(path)) return 0;
+      File file = SPIFFS.open(path, FILE_READ);
+      size_t size = file ? file.size() : 0;
+      if (file) file.close();
+      return size;
+    }
+    static uint32_t segmentCount(HistoryTier tier, uint8_t segment) {
+      return segmentBytes(tier, segment) / sizeof(HistoryRecord);
+    }
+    static size_t readRecords(HistoryTier tier, uint8_t segment, uint32_t index, HistoryRecord *records, size_t n) {
+      char path[24];
+      segmentPath(tier, segment, path, sizeof(path));
+      File file = SPIFFS.open(path, FILE_READ);
+      if (!file) return 0;
+      size_t bytes = 0;
+      if (file.seek(index * sizeof(HistoryRecord))) bytes = file.read((uint8_t *)records, n * sizeof(HistoryRecord));
+      file.close();
+      return bytes / sizeof(HistoryRecord);
+    }
+    static bool readRecord(HistoryTier tier, uint8_t segment, uint32_t index, HistoryRecord &record) {
+      return readRecords(tier, segment, index, &record, 1) == 1;
+    }
+
+    TierState tiers_[HISTORY_TIERS];
+    SpscQueue<Page, 8> fullPages_;
+    BackgroundService flushService_ = nullptr;
+    uint32_t clock_ = 0;              // History clock (seconds)
+    uint32_t lastSampleMs_ = 0;
+    uint32_t pendingMs_ = 0;          // Not counted yet (less than a second)
+    bool ready_ = false;
+    uint32_t pagesWritten_ = 0;
+    uint32_t writeFailures_ = 0;
+    mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+};
@@ -0,0 +1,241 @@
+#pragma once
+
+// HISTORY STREAM
+// --------------
+// Serves a time range of the history (history_store.h) as CSV through a chunked
+// HTTP response, downsampled on the fly to the number of points a chart needs:
+// - records are read from flash a block at a time, straight into the chunk the
+//   web server is about to send, nothing is built in RAM,
+// - Largest-Triangle-Three-Buckets keeps the points that matter visually (peaks,
+//   drops) instead of plain averages. The buckets are time slices, so it runs in
+//   one pass with only two buckets in RAM,
+// - the tier read is the finest one that covers the range with at most
+//   HISTORY_LTTB_BUCKET_MAX records per bucket.
+// RAM use is about 2KB per request, whatever the range.
+//
+//   auto stream = std::make_shared<HistoryCsvStream>(history, from, to, 500, pumps.count());
+//   request->beginChunkedResponse("text/csv", [stream](uint8_t *buffer, size_t maxLen, size_t index) {
+//     return stream->fill(buffer, maxLen);
+//   });
+//
+// CSV: a "# now=..." line (history clock, tier used), the column names, then one line per point:
+//   time,min,mean,max,valid,pump1,...     (seconds, cm, cm, cm, %, %...)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <memory>
+#include "history_store.h"
+
+#define HISTORY_LTTB_BUCKET_MAX 32      // Records kept per bucket (more are averaged, not candidates)
+
+// One pass LTTB over time ordered records: push() them, pop() the ones selected
+class HistoryLttb {
+  public:
+    void begin(uint32_t from, uint32_t to, uint16_t points) {
+      from_ = from;
+      span_ = to - from + 1;
+      buckets_ = points > 3 ? points - 2 : 1;   // First and last points are always kept
+      started_ = hasPrevious_ = false;
+      current_ = 0;
+      bucket_[0].clear();
+      bucket_[1].clear();
+      outHead_ = outCount_ = 0;
+    }
+
+    void push(const HistoryRecord &record) {
+      if (record.valid == 0) return;            // No measure over that period: a gap in the chart
+      last_ = record;
+      if (!started_) {
+        started_ = true;
+        output(record);
+        anchor_ = record;
+        return;
+      }
+      uint32_t index = (uint64_t)(record.time - from_) * buckets_ / span_;
+      Bucket &filling = bucket_[current_];
+      if (filling.count > 0 && index != filling.index) {
+        // The bucket filling up is complete: the previous one can now be decided
+        if (hasPrevious_) select(bucket_[current_ ^ 1], filling.averageTime(), filling.averageValue());
+        hasPrevious_ = true;
+        current_ ^= 1;
+        bucket_[current_].clear();
+      }
+      bucket_[current_].add(record, index, relativeTime(record));
+    }
+
+    // No more records: the last buckets are decided and the last record kept
+    void finish() {
+      if (!started_) return;
+      Bucket &filling = bucket_[current_];
+      if (hasPrevious_) select(bucket_[current_ ^ 1], filling.averageTime(), filling.averageValue());
+      if (filling.count > 0 && filling.last().time == last_.time) filling.count--;   // Kept anyway, not a candidate
+      select(filling, relativeTime(last_), value(last_));
+      if (last_.time != anchor_.time) output(last_);
+      started_ = false;
+    }
+
+    bool pop(HistoryRecord &record) {
+      if (outCount_ == 0) return false;
+      record = out_[outHead_];
+      outHead_ = (outHead_ + 1) % OUT_SIZE;
+      outCount_--;
+      return true;
+    }
+
+  private:
+    struct Bucket {
+      uint32_t index;
+      uint16_t count;                           // Candidates kept
+      uint32_t total;                           // Records seen (averages)
+      float timeSum;                            // Relative to the start of the range
+      float valueSum;
+      HistoryRecord records[HISTORY_LTTB_BUCKET_MAX];
+
+      void clear() { count = 0; total = 0; timeSum = valueSum = 0; }
+      void add(const HistoryRecord &record, uint32_t bucketIndex, float time) {
+        index = bucketIndex;
+        if (count < HISTORY_LTTB_BUCKET_MAX) records[count++] = record;
+        total++;
+        timeSum += time;
+        valueSum += record.distanceMeanMm;
+      }
+      const HistoryRecord &last() const { return records[count - 1]; }
+      float averageTime() const { return timeSum / total; }
+      float averageValue() const { return valueSum / total; }
+    };
+
+    float relativeTime(const HistoryRecord &record) const { return (float)(record.time - from_); }
+    static float value(const HistoryRecord &record) { return record.distanceMeanMm; }
+
+    // Keeps the record of the bucket making the largest triangle with the anchor (last point kept)
+    // and the average of the next bucket (times relative to the start of the range)
+    void select(const Bucket &bucket, float nextTime, float nextValue) {
+      if (bucket.count == 0) return;
+      float anchorTime = relativeTime(anchor_), anchorValue = value(anchor_);
+      int best = 0;
+      float bestArea = -1;
+      for (int i = 0; i < bucket.count; i++) {
+        float area = (anchorTime - nextTime) * (value(bucket.records[i]) - anchorValue)
+                     - (anchorTime - relativeTime(bucket.records[i])) * (nextValue - anchorValue);
+        if (area < 0) area = -area;
+        if (area > bestArea) {
+          bestArea = area;
+          best = i;
+        }
+      }
+      anchor_ = bucket.records[best];
+      output(anchor_);
+    }
+
+    void output(const HistoryRecord &record) {
+      out_[(outHead_ + outCount_) % OUT_SIZE] = record;
+      outCount_++;
+    }
+
+    static const int OUT_SIZE = 4;              // At most 3 points come out of a single push() / finish(): pop() them all before the next
+    uint32_t from_ = 0, span_ = 1, buckets_ = 1;
+    bool started_ = false, hasPrevious_ = false;
+    uint8_t current_ = 0;                       // Bucket filling up, the other one waits for its average
+    Bucket bucket_[2];
+    HistoryRecord anchor_, last_;
+    HistoryRecord out_[OUT_SIZE];
+    uint8_t outHead_ = 0, outCount_ = 0;
+};
+
+// Finest tier covering [from, to] without too many records per bucket (and holding data that old)
+inline HistoryTier historyTierFor(const HistoryStore &store, uint32_t from, uint32_t to, uint16_t points) {
+  for (int t = HISTORY_MINUTES; t < HISTORY_DAYS; t++) {
+    HistoryTier tier = (HistoryTier)t;
+    uint32_t records = (to - from) / HistoryStore::periodSeconds(tier);
+    uint32_t oldest = store.oldestTime(tier);
+    // A young device: the coarser tier doesn't go further back either
+    bool coversRange = oldest <= from || oldest <= store.oldestTime((HistoryTier)(t + 1));
+    if (records <= (uint32_t)points * HISTORY_LTTB_BUCKET_MAX && coversRange) return tier;
+  }
+  return HISTORY_DAYS;
+}
+
+class HistoryCsvStream {
+  public:
+    HistoryCsvStream(const HistoryStore &store, uint32_t from, uint32_t to, uint16_t points, uint8_t pumps)
+      : store_(store), from_(from), to_(to), pumps_(pumps < HISTORY_MAX_PUMPS ? pumps : HISTORY_MAX_PUMPS) {
+      tier_ = historyTierFor(store, from, to, points);
+      cursor_ = store.seek(tier_, from);
+      lttb_.begin(from, to, points);
+      static const char *tierNames[HISTORY_TIERS] = { "minutes", "hours", "days" };
+      lineLength_ = snprintf(line_, sizeof(line_), "# now=%u tier=%s period=%u\ntime,min,mean,max,valid", (unsigned)store.now(),
+                             tierNames[tier_], (unsigned)HistoryStore::periodSeconds(tier_));
+      for (uint8_t i = 0; i < pumps_; i++) lineLength_ += snprintf(line_ + lineLength_, sizeof(line_) - lineLength_, ",pump%u", i + 1);
+      lineLength_ += snprintf(line_ + lineLength_, sizeof(line_) - lineLength_, "\n");
+    }
+
+    // Chunked response filler: as much as fits in the buffer, 0 once everything has been sent
+    size_t fill(uint8_t *buffer, size_t maxLen) {
+      size_t length = 0;
+      while (length < maxLen) {
+        if (lineSent_ < lineLength_) {
+          size_t n = lineLength_ - lineSent_ < maxLen - length ? lineLength_ - lineSent_ : maxLen - length;
+          memcpy(buffer + length, line_ + lineSent_, n);
+          length += n;
+          lineSent_ += n;
+          continue;
+        }
+        HistoryRecord record;
+        if (lttb_.pop(record)) {
+          formatLine(record);
+          continue;
+        }
+        if (done_) break;
+        pushNext();
+      }
+      return length;
+    }
+
+    HistoryTier tier() const { return tier_; }
+    uint32_t recordsRead() const { return recordsRead_; }
+
+  private:
+    // Next record into the LTTB, from flash a block at a time, until the end of the range.
+    // One record per call: what the LTTB outputs is popped before the next push
+    void pushNext() {
+      if (blockIndex_ == blockCount_) {
+        blockCount_ = store_.read(cursor_, block_, BLOCK_RECORDS);
+        blockIndex_ = 0;
+      }
+      if (blockIndex_ == blockCount_ || block_[blockIndex_].time > to_) {
+        lttb_.finish();
+        done_ = true;
+        return;
+      }
+      const HistoryRecord &record = block_[blockIndex_++];
+      if (record.time < from_) return;          // Only when the range starts after what is on flash (RAM page)
+      lttb_.push(record);
+      recordsRead_++;
+    }
+
+    void formatLine(const HistoryRecord &r) {
+      int length = snprintf(line_, sizeof(line_), "%u,%.1f,%.1f,%.1f,%u", (unsigned)r.time, r.distanceMinMm / 10.0,
+                            r.distanceMeanMm / 10.0, r.distanceMaxMm / 10.0, percent(r.valid));
+      for (uint8_t i = 0; i < pumps_; i++) length += snprintf(line_ + length, sizeof(line_) - length, ",%u", percent(r.pumpDuty[i]));
+      length += snprintf(line_ + length, sizeof(line_) - length, "\n");
+      lineLength_ = length;
+      lineSent_ = 0;
+    }
+    static unsigned percent(uint8_t ratio) { return (ratio * 100U + HISTORY_RATIO_SCALE / 2) / HISTORY_RATIO_SCALE; }
+
+    static const size_t BLOCK_RECORDS = 16;
+    const HistoryStore &store_;
+    uint32_t from_, to_;
+    uint8_t pumps_;
+    HistoryTier tier_;
+    HistoryStore::Cursor cursor_;
+    HistoryLttb lttb_;
+    HistoryRecord block_[BLOCK_RECORDS];
+    size_t blockCount_ = 0, blockIndex_ = 0;
+    char line_[128];                            // Line being sent (a chunk can end in the middle of it)
+    size_t lineLength_ = 0, lineSent_ = 0;
+    bool done_ = false;
+    uint32_t recordsRead_ = 0;
+};
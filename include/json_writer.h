@@ -0,0 +1,135 @@
+#pragma once
+
+// JSON WRITER
+// -----------
+// Streams a flat JSON object straight into a caller provided (fixed, preallocated)
+// buffer: no String temporaries, no heap allocation at all.
+//
+//   char buff[256];
+//   JsonWriter json(buff, sizeof(buff));
+//   json.add("sensor", 24.5f);
+//   json.add("opsmode", "AUTO");
+//   json.end();                        // buff now holds {"sensor":24.50,"opsmode":"AUTO"}
+//
+// Numbers are formatted by hand (floats as fixed point), which is also much faster
+// than snprintf on the ESP32. NaN, Inf and floats too big for 32 bits once scaled
+// are written as null. If the buffer is too small the output is cut and
+// overflowed() returns true, the buffer always stays null terminated.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+class JsonWriter {
+  public:
+    JsonWriter(char *buffer, size_t size) : buffer_(buffer), size_(size) {
+      buffer_[0] = '\0';
+      put('{');
+    }
+
+    // Close the object, returns the JSON length
+    size_t end() {
+      put('}');
+      return length_;
+    }
+
+    void add(const char *key, const char *value) {
+      addKey(key);
+      putString(value);
+    }
+    void add(const char *key, long value) {
+      addKey(key);
+      putInteger(value);
+    }
+    void add(const char *key, int value) { add(key, (long)value); }
+    // Unsigned values (millis() timestamps...) keep their own path: long is 32 bits on
+    // the ESP32, anything past 2^31 would come out negative
+    void add(const char *key, unsigned long value) {
+      addKey(key);
+      putUnsigned(value);
+    }
+    void add(const char *key, unsigned int value) { add(key, (unsigned long)value); }
+    void add(const char *key, bool value) { add(key, (long)(value ? 1 : 0)); }
+    void add(const char *key, float value, uint8_t decimals = 2) {
+      addKey(key);
+      putFloat(value, decimals);
+    }
+    // Value already serialized as JSON (array, object...), copied as is
+    void addRaw(const char *key, const char *json) {
+      addKey(key);
+      put(json);
+    }
+
+    const char *c_str() const { return buffer_; }
+    size_t length() const { return length_; }
+    bool overflowed() const { return overflowed_; }
+
+  private:
+    void put(char c) {
+      if (length_ + 1 < size_) {
+        buffer_[length_++] = c;
+        buffer_[length_] = '\0';
+      } else {
+        overflowed_ = true;
+      }
+    }
+    void put(const char *s) {
+      while (*s) put(*s++);
+    }
+    void addKey(const char *key) {
+      if (fields_++ > 0) put(',');
+      putString(key);
+      put(':');
+    }
+    void putString(const char *s) {
+      put('"');
+      for (; *s; s++) {
+        unsigned char c = *s;
+        if (c == '"' || c == '\\') { put('\\'); put(c); }
+        else if (c == '\n') put("\\n");
+        else if (c < 0x20) put(' ');       // Other control characters are just not welcome here
+        else put(c);
+      }
+      put('"');
+    }
+    void putInteger(long value) {
+      if (value < 0) put('-');
+      putUnsigned(value < 0 ? 0UL - (unsigned long)value : (unsigned long)value);
+    }
+    void putUnsigned(unsigned long value) {
+      char digits[20];
+      int n = 0;
+      do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+      } while (value > 0);
+      while (n > 0) put(digits[--n]);
+    }
+    void putFloat(float value, uint8_t decimals) {
+      long scale = 1;
+      for (uint8_t i = 0; i < decimals; i++) scale *= 10;
+      bool negative = value < 0;
+      float magnitude = (negative ? -value : value) * scale + 0.5f;
+      // NaN, Inf, or too big for 32 bits once scaled (a corrupt sensor packet...)
+      if (!(magnitude < 4294967296.0f)) {
+        put("null");
+        return;
+      }
+      unsigned long scaled = (unsigned long)magnitude;
+      if (negative && scaled > 0) put('-');
+      putUnsigned(scaled / scale);
+      if (decimals > 0) {
+        put('.');
+        unsigned long fraction = scaled % scale;
+        for (long d = scale / 10; d > 0; d /= 10) {
+          put('0' + (fraction / d) % 10);
+        }
+      }
+    }
+
+    char *buffer_;
+    size_t size_;
+    size_t length_ = 0;
+    int fields_ = 0;
+    bool overflowed_ = false;
+};
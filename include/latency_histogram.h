@@ -0,0 +1,60 @@
+#pragma once
+
+// LATENCY HISTOGRAM
+// -----------------
+// Fixed buckets (1 ms .. 1 s, roughly 1-2-5 steps), no allocation: cheap
+// enough to record from anywhere, precise enough to see where latencies sit.
+//
+//   LatencyHistogram latency;
+//   latency.record(micros() - startedUs);
+//   latency.percentileUs(95);      // Upper bound of the bucket holding the 95th percentile
+
+#include <stddef.h>
+#include <stdint.h>
+
+class LatencyHistogram {
+  public:
+    static const int BUCKETS = 11;
+
+    void record(uint32_t us) {
+      int bucket = 0;
+      while (bucket < BUCKETS - 1 && us > bucketLimitUs(bucket)) bucket++;
+      counts_[bucket]++;
+      count_++;
+      totalUs_ += us;
+      if (us > maxUs_) maxUs_ = us;
+    }
+
+    void clear() {
+      for (int i = 0; i < BUCKETS; i++) counts_[i] = 0;
+      count_ = 0;
+      totalUs_ = 0;
+      maxUs_ = 0;
+    }
+
+    // Bucket upper limits, the last bucket has no limit
+    static uint32_t bucketLimitUs(int bucket) {
+      static const uint32_t limits[BUCKETS] = {1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000, 1000000, UINT32_MAX};
+      return limits[bucket];
+    }
+
+    uint32_t bucketCount(int bucket) const { return counts_[bucket]; }
+    uint32_t count() const { return count_; }
+    uint32_t maxUs() const { return maxUs_; }
+    uint32_t meanUs() const { return count_ ? totalUs_ / count_ : 0; }
+
+    uint32_t percentileUs(int percent) const {
+      uint32_t target = ((uint64_t)count_ * percent + 99) / 100, seen = 0;
+      for (int i = 0; i < BUCKETS; i++) {
+        seen += counts_[i];
+        if (seen >= target && seen > 0) return i == BUCKETS - 1 ? maxUs_ : bucketLimitUs(i);
+      }
+      return 0;
+    }
+
+  private:
+    uint32_t counts_[BUCKETS] = {};
+    uint32_t count_ = 0;
+    uint64_t totalUs_ = 0;
+    uint32_t maxUs_ = 0;
+};
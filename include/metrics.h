@@ -0,0 +1,301 @@
+#pragma once
+
+// METRICS
+// -------
+// Counters, gauges and latency histograms for the hot paths, exported as
+// Prometheus text (GET /metrics) so the real numbers can be scraped from the
+// field: loop() jitter, how long the analysis / websocket / display / radio
+// take, ESP-NOW packets received vs rejected, heap and stack low-water marks.
+//
+// - Lock-free: every update is one relaxed atomic add/store, so metrics can be
+//   updated from loop(), the WiFi callbacks or a background service, and read by
+//   the web server task at any time.
+// - Metrics are global objects: they register themselves (in declaration order)
+//   at static construction, nothing is allocated afterwards.
+// - Latencies are measured with the CPU cycle counter (ESP.getCycleCount()),
+//   fixed buckets from 10us to 1s. The counter wraps every ~18s at 240MHz,
+//   longer durations are not measured right (nothing should take that long).
+// - Built with -DMETRICS_ENABLED=0, every class below is an empty stub: no atomics,
+//   no registry, no cycle counter reads, and main.cpp drops the /metrics route.
+//
+//   MetricCounter packets("dmz_espnow_packets_total", "ESP-NOW packets", "result=\"received\"");
+//   MetricHistogram analysis("dmz_analysis_seconds", "Water level analysis");
+//   packets.inc();
+//   { MetricTimer timer(analysis); analyzeWaterLevels(); }
+//
+// Metrics of the same family (same name, different labels) must be declared
+// one after the other: HELP / TYPE are only written before the first one.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "hal.h"
+
+#ifndef METRICS_ENABLED
+#define METRICS_ENABLED 1
+#endif
+
+#if METRICS_ENABLED
+
+#include <atomic>
+
+class Metric {
+  public:
+    enum Type : uint8_t { COUNTER, GAUGE, HISTOGRAM };
+
+    Metric(Type type, const char *name, const char *help, const char *labels) : type_(type), name_(name), help_(help), labels_(labels) {
+      // Static construction (single threaded): appended, so the export keeps the declaration order
+      Metric **last = &first();
+      while (*last) last = &(*last)->next_;
+      *last = this;
+    }
+    Metric(const Metric &) = delete;
+    Metric &operator=(const Metric &) = delete;
+
+    static Metric *&first() {
+      static Metric *head = nullptr;
+      return head;
+    }
+    Metric *next() const { return next_; }
+    Type type() const { return type_; }
+    const char *name() const { return name_; }
+    const char *help() const { return help_; }
+    const char *labels() const { return labels_; }
+
+  private:
+    Type type_;
+    const char *name_;
+    const char *help_;
+    const char *labels_;                        // "key=\"value\",..." or nullptr
+    Metric *next_ = nullptr;
+};
+
+class MetricCounter : public Metric {
+  public:
+    MetricCounter(const char *name, const char *help, const char *labels = nullptr) : Metric(COUNTER, name, help, labels) {}
+    void inc(uint32_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    // Counters kept elsewhere (queue drops...) are copied in before the export
+    void set(uint32_t value) { value_.store(value, std::memory_order_relaxed); }
+    uint32_t value() const { return value_.load(std::memory_order_relaxed); }
+  private:
+    std::atomic<uint32_t> value_{0};
+};
+
+class MetricGauge : public Metric {
+  public:
+    MetricGauge(const char *name, const char *help, const char *labels = nullptr) : Metric(GAUGE, name, help, labels) {}
+    void set(int32_t value) { value_.store(value, std::memory_order_relaxed); }
+    int32_t value() const { return value_.load(std::memory_order_relaxed); }
+  private:
+    std::atomic<int32_t> value_{0};
+};
+
+class MetricHistogram : public Metric {
+  public:
+    static const int BUCKETS = 12;
+
+    MetricHistogram(const char *name, const char *help, const char *labels = nullptr) : Metric(HISTOGRAM, name, help, labels) {}
+
+    void observeCycles(uint32_t cycles) { observeUs(cycles / cyclesPerUs()); }
+
+    void observeUs(uint32_t us) {
+      int bucket = 0;
+      while (bucket < BUCKETS - 1 && us > bucketLimitUs(bucket)) bucket++;
+      counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+      // 32 bits of microseconds wrap after ~71 minutes of total time: the wraps are counted apart
+      uint32_t before = sumUs_.fetch_add(us, std::memory_order_relaxed);
+      if (before + us < before) sumWraps_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Bucket upper limits, the last bucket (+Inf) has no limit
+    static uint32_t bucketLimitUs(int bucket) {
+      static const uint32_t limits[BUCKETS] = {10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000, 500000, 1000000, UINT32_MAX};
+      return limits[bucket];
+    }
+    uint32_t bucketCount(int bucket) const { return counts_[bucket].load(std::memory_order_relaxed); }
+    uint64_t sumUs() const {
+      for (;;) {
+        uint32_t wraps = sumWraps_.load(std::memory_order_acquire);
+        uint32_t sum = sumUs_.load(std::memory_order_acquire);
+        if (wraps == sumWraps_.load(std::memory_order_acquire)) return ((uint64_t)wraps << 32) | sum;
+      }
+    }
+
+    static uint32_t cyclesPerUs() {
+      static uint32_t cycles = ESP.getCpuFreqMHz();
+      return cycles;
+    }
+
+  private:
+    std::atomic<uint32_t> counts_[BUCKETS] = {};
+    std::atomic<uint32_t> sumUs_{0};
+    std::atomic<uint32_t> sumWraps_{0};
+};
+
+// Measures from construction (or start()) to stop() or destruction, whichever comes first
+class MetricTimer {
+  public:
+    explicit MetricTimer(MetricHistogram &histogram, bool startNow = true) : histogram_(histogram) {
+      if (startNow) start();
+    }
+    ~MetricTimer() { stop(); }
+    void start() {
+      startedCycles_ = ESP.getCycleCount();
+      running_ = true;
+    }
+    void stop() {
+      if (!running_) return;
+      running_ = false;
+      histogram_.observeCycles(ESP.getCycleCount() - startedCycles_);
+    }
+  private:
+    MetricHistogram &histogram_;
+    uint32_t startedCycles_ = 0;
+    bool running_ = false;
+};
+
+// Prometheus text exposition of all the metrics, for a chunked response: one line
+// at a time into the server buffer, whatever the number of metrics.
+//
+//   auto stream = std::make_shared<MetricsTextStream>();
+//   request->beginChunkedResponse("text/plain; version=0.0.4", [stream](uint8_t *buffer, size_t maxLen, size_t index) {
+//     return stream->fill(buffer, maxLen);
+//   });
+class MetricsTextStream {
+  public:
+    // Chunked response filler: as much as fits in the buffer, 0 once everything has been sent
+    size_t fill(uint8_t *buffer, size_t maxLen) {
+      size_t length = 0;
+      while (length < maxLen) {
+        if (lineSent_ < lineLength_) {
+          size_t n = lineLength_ - lineSent_ < maxLen - length ? lineLength_ - lineSent_ : maxLen - length;
+          memcpy(buffer + length, line_ + lineSent_, n);
+          length += n;
+          lineSent_ += n;
+          continue;
+        }
+        if (!metric_) break;
+        nextLine();
+      }
+      return length;
+    }
+
+  private:
+    // Lines of the current metric: HELP and TYPE (first of its family), then its samples
+    void nextLine() {
+      const Metric &m = *metric_;
+      bool header = !previous_ || strcmp(previous_->name(), m.name()) != 0;
+      int line = lineIndex_++;
+      if (!header) line += 2;
+      lineSent_ = 0;
+      if (line == 0) {
+        format("# HELP %s %s\n", m.name(), m.help());
+        return;
+      }
+      if (line == 1) {
+        static const char *types[] = { "counter", "gauge", "histogram" };
+        format("# TYPE %s %s\n", m.name(), types[m.type()]);
+        return;
+      }
+      int sample = line - 2;
+      const char *labels = m.labels() ? m.labels() : "";
+      const char *separator = m.labels() ? "," : "";
+      bool last = true;
+      switch (m.type()) {
+        case Metric::COUNTER:
+          format(m.labels() ? "%s{%s} %u\n" : "%s%s %u\n", m.name(), labels, (unsigned)static_cast<const MetricCounter &>(m).value());
+          break;
+        case Metric::GAUGE:
+          format(m.labels() ? "%s{%s} %d\n" : "%s%s %d\n", m.name(), labels, (int)static_cast<const MetricGauge &>(m).value());
+          break;
+        case Metric::HISTOGRAM: {
+          const MetricHistogram &h = static_cast<const MetricHistogram &>(m);
+          if (sample == 0) {
+            // Snapshot: the cumulative buckets and the count stay consistent with each other
+            cumulative_ = 0;
+            for (int i = 0; i < MetricHistogram::BUCKETS; i++) snapshot_[i] = h.bucketCount(i);
+          }
+          if (sample < MetricHistogram::BUCKETS) {
+            cumulative_ += snapshot_[sample];
+            char le[16];
+            if (sample == MetricHistogram::BUCKETS - 1) strcpy(le, "+Inf");
+            else formatSeconds(le, sizeof(le), MetricHistogram::bucketLimitUs(sample));
+            format("%s_bucket{%s%sle=\"%s\"} %u\n", m.name(), labels, separator, le, (unsigned)cumulative_);
+            last = false;
+          } else if (sample == MetricHistogram::BUCKETS) {
+            char sum[24];
+            formatSeconds(sum, sizeof(sum), h.sumUs());
+            format(m.labels() ? "%s_sum{%s} %s\n" : "%s_sum%s %s\n", m.name(), labels, sum);
+            last = false;
+          } else {
+            format(m.labels() ? "%s_count{%s} %u\n" : "%s_count%s %u\n", m.name(), labels, (unsigned)cumulative_);
+          }
+          break;
+        }
+      }
+      if (last) {
+        previous_ = metric_;
+        metric_ = metric_->next();
+        lineIndex_ = 0;
+      }
+    }
+
+    void format(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+      va_list args;
+      va_start(args, fmt);
+      int n = vsnprintf(line_, sizeof(line_), fmt, args);
+      va_end(args);
+      lineLength_ = n < 0 ? 0 : (size_t)n < sizeof(line_) ? n : sizeof(line_) - 1;
+    }
+
+    // Microseconds as seconds, without the float formatting: 50 -> "0.00005"
+    static void formatSeconds(char *out, size_t size, uint64_t us) {
+      int n = snprintf(out, size, "%llu.%06u", (unsigned long long)(us / 1000000), (unsigned)(us % 1000000));
+      while (n > 0 && out[n - 1] == '0') out[--n] = '\0';
+      if (n > 0 && out[n - 1] == '.') out[--n] = '\0';
+    }
+
+    const Metric *metric_ = Metric::first();
+    const Metric *previous_ = nullptr;
+    int lineIndex_ = 0;
+    uint32_t snapshot_[MetricHistogram::BUCKETS];
+    uint32_t cumulative_ = 0;
+    char line_[160];
+    size_t lineLength_ = 0, lineSent_ = 0;
+};
+
+#else
+
+// Metrics disabled: same API, nothing left once inlined
+class MetricCounter {
+  public:
+    constexpr MetricCounter(const char *, const char *, const char * = nullptr) {}
+    void inc(uint32_t = 1) {}
+    void set(uint32_t) {}
+    uint32_t value() const { return 0; }
+};
+
+class MetricGauge {
+  public:
+    constexpr MetricGauge(const char *, const char *, const char * = nullptr) {}
+    void set(int32_t) {}
+    int32_t value() const { return 0; }
+};
+
+class MetricHistogram {
+  public:
+    constexpr MetricHistogram(const char *, const char *, const char * = nullptr) {}
+    void observeCycles(uint32_t) {}
+    void observeUs(uint32_t) {}
+};
+
+class MetricTimer {
+  public:
+    explicit MetricTimer(MetricHistogram &, bool = true) {}
+    void start() {}
+    void stop() {}
+};
+
+#endif
@@ -0,0 +1,260 @@
+#pragma once
+
+// OLED SCREEN (retained mode)
+// ---------------------------
+// Keeps the SSD1306 refreshes small: instead of clearing and redrawing a whole
+// screen then sending the full 1 KB frame over I2C every time,
+//
+// - beginScreen() only returns true when the screen shown changes: that is
+//   the only time the framebuffer is cleared and the static labels drawn,
+// - value fields (OledField) are only re-rendered when their text changed,
+// - the frame is only published by loop(), a background task compares it with
+//   a copy of what the panel shows and only sends the pages/columns that differ.
+//
+//   if (oled.beginScreen(SCREEN_STATUS)) {
+//     display.setCursor(0, 0);
+//     display.print("Level:");            // Static label, drawn once
+//   }
+//   oled.print(levelField, levelText);    // Redrawn only if levelText changed
+//   oled.publish();                        // Background task: oled.flushPublished()
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "hal.h"
+#include "latency_histogram.h"
+
+// A value shown at a fixed place, always drawn over its full width (text size 1)
+struct OledField {
+  int16_t x, y;
+  uint8_t width;                // In characters, longer texts are cut
+  uint32_t generation = 0;      // Screen generation it was last drawn for (0: never)
+  char text[22] = "";
+};
+
+class OledScreen {
+  public:
+    static const int WIDTH = 128;
+    static const int PAGES = 8;               // 64 pixels high, 8 pixels per page
+
+    OledScreen(Adafruit_SSD1306 &display, TwoWire &wire, uint8_t i2cAddress)
+      : display_(display), wire_(wire), i2cAddress_(i2cAddress) {}
+
+    // Returns true when the screen has to be drawn from scratch (screen changed):
+    // the framebuffer has been cleared, draw the static labels
+    bool beginScreen(int screen) {
+      if (screen == screen_) return false;
+      screen_ = screen;
+      generation_++;
+      display_.clearDisplay();
+      display_.setTextSize(1);
+      display_.setTextColor(SSD1306_WHITE);
+      return true;
+    }
+
+    void print(OledField &field, const char *text) {
+      if (field.generation == generation_ && strncmp(field.text, text, sizeof(field.text)) == 0) return;
+      bool redrawAll = field.generation != generation_;
+      char previous[sizeof(field.text)];
+      memcpy(previous, field.text, sizeof(previous));
+      field.generation = generation_;
+      strncpy(field.text, text, sizeof(field.text) - 1);
+      field.text[sizeof(field.text) - 1] = '\0';
+
+      // Only the characters that changed are redrawn (so only their columns get
+      // flushed), with an opaque background and padded with spaces so the
+      // previous value is fully overwritten
+      display_.setTextSize(1);
+      display_.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
+      size_t len = strlen(field.text), previousLen = strlen(previous);
+      for (uint8_t i = 0; i < field.width; i++) {
+        char c = i < len ? field.text[i] : ' ';
+        char shown = i < previousLen ? previous[i] : ' ';
+        if (!redrawAll && c == shown) continue;
+        display_.setCursor(field.x + i * 6, field.y);
+        display_.write((uint8_t)c);
+      }
+      display_.setTextColor(SSD1306_WHITE);
+    }
+
+    // Double buffering: the screens are drawn into the display framebuffer (back
+    // buffer) by loop(), publish() copies it to the front buffer in a blink and
+    // flushPublished(), called from a background task, sends the front buffer
+    // regions that differ from what the panel shows. The I2C transfer never
+    // blocks loop(), frames published faster than they can be sent are coalesced.
+    void publish() {
+      portENTER_CRITICAL(&mux_);
+      memcpy(front_, display_.getBuffer(), sizeof(front_));
+      if (published_) framesCoalesced_++;
+      published_ = true;
+      if (inputPending_) {
+        // This frame answers the input
+        frontAnswersInput_ = true;
+        frontInputUs_ = inputUs_;
+        inputPending_ = false;
+      }
+      portEXIT_CRITICAL(&mux_);
+    }
+
+    // Background task side, returns false when there was nothing to send
+    bool flushPublished() {
+      Window windows[PAGES];
+      int count = 0;
+      bool answersInput = false;
+      uint32_t inputUs = 0;
+      portENTER_CRITICAL(&mux_);
+      if (!published_) {
+        portEXIT_CRITICAL(&mux_);
+        return false;
+      }
+      // Only the dirty windows are copied to the panel buffer (that is what will be
+      // on the panel), then sent from there without holding the lock
+      count = dirtyWindows(front_, windows);
+      for (int i = 0; i < count; i++) {
+        for (int page = windows[i].pageStart; page <= windows[i].pageEnd; page++) {
+          memcpy(panel_ + page * WIDTH + windows[i].colStart, front_ + page * WIDTH + windows[i].colStart,
+                 windows[i].colEnd - windows[i].colStart + 1);
+        }
+      }
+      panelKnown_ = true;
+      published_ = false;
+      answersInput = frontAnswersInput_;
+      inputUs = frontInputUs_;
+      frontAnswersInput_ = false;
+      portEXIT_CRITICAL(&mux_);
+
+      size_t sent = 0;
+      for (int i = 0; i < count; i++) sent += sendWindow(panel_, windows[i]);
+      flushes_++;
+      bytesSent_ += sent;
+      if (answersInput) inputLatency_.record(micros() - inputUs);
+      return true;
+    }
+
+    // Synchronous publish + flush (boot screens, before the background task runs)
+    void flush() {
+      publish();
+      flushPublished();
+    }
+
+    // A button (or any input) was handled: the next frame published answers it,
+    // the time until it is on the panel goes to inputLatency()
+    void markInput() {
+      if (!inputPending_) inputUs_ = micros();
+      inputPending_ = true;
+    }
+    const LatencyHistogram &inputLatency() const { return inputLatency_; }
+
+    uint32_t flushes() const { return flushes_; }
+    uint64_t bytesSent() const { return bytesSent_; }
+    uint32_t framesCoalesced() const { return framesCoalesced_; }
+
+  private:
+    static const size_t WINDOW_SETUP_BYTES = 8 + 2;     // Commands transaction + one more data transaction
+    static const size_t CHUNK = 31;                     // Pixel bytes per I2C transaction (32 with the control byte)
+
+    struct Window {
+      int pageStart, pageEnd, colStart, colEnd;
+    };
+
+    static int min(int a, int b) { return a < b ? a : b; }
+    static int max(int a, int b) { return a > b ? a : b; }
+
+    // Regions of frame that differ from the panel, returns how many
+    int dirtyWindows(const uint8_t *frame, Window *windows) const {
+      int first[PAGES], last[PAGES];
+      for (int page = 0; page < PAGES; page++) {
+        first[page] = WIDTH;
+        last[page] = -1;
+        const uint8_t *now = frame + page * WIDTH;
+        const uint8_t *shown = panel_ + page * WIDTH;
+        if (!panelKnown_) {
+          first[page] = 0;
+          last[page] = WIDTH - 1;
+          continue;
+        }
+        for (int col = 0; col < WIDTH; col++) {
+          if (now[col] != shown[col]) { first[page] = col; break; }
+        }
+        for (int col = WIDTH - 1; col >= first[page]; col--) {
+          if (now[col] != shown[col]) { last[page] = col; break; }
+        }
+      }
+
+      // Adjacent dirty pages are sent as one rectangle when the extra columns
+      // cost less than another window setup
+      int count = 0;
+      int page = 0;
+      while (page < PAGES) {
+        if (last[page] < 0) { page++; continue; }
+        Window window = {page, page, first[page], last[page]};
+        size_t separate = window.colEnd - window.colStart + 1;
+        while (window.pageEnd + 1 < PAGES && last[window.pageEnd + 1] >= 0) {
+          int next = window.pageEnd + 1;
+          int mergedStart = min(window.colStart, first[next]);
+          int mergedEnd = max(window.colEnd, last[next]);
+          size_t nextWidth = last[next] - first[next] + 1;
+          size_t merged = (size_t)(mergedEnd - mergedStart + 1) * (next - window.pageStart + 1);
+          if (merged > separate + nextWidth + WINDOW_SETUP_BYTES) break;
+          window.pageEnd = next;
+          window.colStart = mergedStart;
+          window.colEnd = mergedEnd;
+          separate += nextWidth;
+        }
+        windows[count++] = window;
+        page = window.pageEnd + 1;
+      }
+      return count;
+    }
+
+    size_t sendWindow(const uint8_t *frame, const Window &window) {
+      // Window setup: all the commands in a single I2C transaction
+      wire_.beginTransmission(i2cAddress_);
+      wire_.write((uint8_t)0x00);           // Co = 0, D/C = 0: command bytes follow
+      wire_.write((uint8_t)0x22);           // Page address range
+      wire_.write((uint8_t)window.pageStart);
+      wire_.write((uint8_t)window.pageEnd);
+      wire_.write((uint8_t)0x21);           // Column address range
+      wire_.write((uint8_t)window.colStart);
+      wire_.write((uint8_t)window.colEnd);
+      wire_.endTransmission();
+
+      // Horizontal addressing mode: the window is filled row of pages by row of pages
+      size_t sent = 0, inChunk = 0;
+      for (int page = window.pageStart; page <= window.pageEnd; page++) {
+        for (int col = window.colStart; col <= window.colEnd; col++) {
+          if (inChunk == 0) {
+            wire_.beginTransmission(i2cAddress_);
+            wire_.write((uint8_t)0x40);     // Co = 0, D/C = 1: data bytes follow
+          }
+          wire_.write(frame[page * WIDTH + col]);
+          sent++;
+          if (++inChunk == CHUNK) {
+            wire_.endTransmission();
+            inChunk = 0;
+          }
+        }
+      }
+      if (inChunk > 0) wire_.endTransmission();
+      return sent;
+    }
+
+    Adafruit_SSD1306 &display_;
+    TwoWire &wire_;
+    uint8_t i2cAddress_;
+    uint8_t front_[WIDTH * PAGES];      // Last frame published, waiting to be sent
+    uint8_t panel_[WIDTH * PAGES];      // What the panel currently shows
+    bool published_ = false;
+    bool panelKnown_ = false;
+    portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+    int screen_ = -1000;
+    uint32_t generation_ = 0;
+    uint32_t flushes_ = 0;
+    uint64_t bytesSent_ = 0;
+    uint32_t framesCoalesced_ = 0;
+    bool inputPending_ = false;
+    uint32_t inputUs_ = 0;
+    bool frontAnswersInput_ = false;
+    uint32_t frontInputUs_ = 0;
+    LatencyHistogram inputLatency_;
+};
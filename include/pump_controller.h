@@ -0,0 +1,148 @@
+#pragma once
+
+// PUMP CONTROLLER
+// ---------------
+// All the pumps in one contiguous array, each one with its own relay, the sensor
+// it follows, its policy (thresholds, overheat protection) and its timers. One
+// evaluate() runs decidePump() (pump_decision.h) for every pump and switches the
+// relays: driving one more pump is one more PumpConfig, not more code.
+//
+//   PumpController<8> pumps;
+//   int id = pumps.add({ "Public Klong", 14, 12, &distanceCm, policy, true });
+//   pumps.updateTimers();           // Every tick
+//   pumps.evaluate(masterMode);     // Every analysis
+//   pumps[id].powered;
+//
+// Relays are active LOW, the LED mirrors the relay.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hal.h"
+#include "pump_decision.h"
+
+struct PumpConfig {
+  const char *name;
+  uint8_t relayPin;
+  uint8_t ledPin;
+  const float *waterDistanceCm;   // Sensor binding: the filtered distance this pump follows (nullptr: no sensor)
+  PumpPolicy policy;
+  bool enabled;                   // Disabled pumps are kept off (relay wired, not in service yet)
+};
+
+struct Pump {
+  PumpConfig config;
+  PumpState state;
+  PumpState previous;             // Before the last evaluation
+  bool powered;
+  uint32_t startedMs;             // millis() when the pump started
+  uint32_t runningSec;            // Since the pump started (0 when off)
+  uint32_t cooldownStartMs;       // millis() when the overheat protection started
+  PumpDecision decision;          // Last one (reason, analysis text)
+
+  // Display format of the runtime: minutes, seconds as decimals (5.30 = 5 min 30 sec)
+  float operatingTimeMin() const {
+    return (runningSec / 60) + ((runningSec % 60) / 100.0);
+  }
+  uint32_t cooldownEndMs() const {
+    return cooldownStartMs + (uint32_t)(config.policy.cooldownMinutes * 60000UL);
+  }
+};
+
+template <size_t N>
+class PumpController {
+  static_assert(N > 0 && N <= 32, "PumpController: at most 32 pumps");
+
+  public:
+    // Called on every start/stop request (also when the pump was already in that state)
+    typedef void (*PowerHook)(int id, const Pump &pump);
+
+    // Configures the relay right away (off). Returns the pump id (-1 if full)
+    int add(const PumpConfig &config) {
+      if (count_ == N) return -1;
+      Pump &pump = pumps_[count_];
+      pump = {};
+      pump.config = config;
+      pump.state = pump.previous = PumpState::Off;
+      pump.decision = { PumpEvent::WaterLow, PumpState::Off, false, "" };
+      pinMode(config.relayPin, OUTPUT);
+      pinMode(config.ledPin, OUTPUT);
+      writeRelay(pump, false);
+      return count_++;
+    }
+
+    void setPowerHook(PowerHook hook) { powerHook_ = hook; }
+
+    void start(int id) { setPower(id, true); }
+    void stop(int id) { setPower(id, false); }
+
+    void setPower(int id, bool on) {
+      Pump &pump = pumps_[id];
+      if (!pump.config.enabled) on = false;
+      bool changed = pump.powered != on;
+      pump.powered = on;
+      writeRelay(pump, on);
+      if (changed) {
+        pump.startedMs = on ? millis() : 0;
+        pump.runningSec = 0;
+      }
+      if (powerHook_) powerHook_(id, pump);
+    }
+
+    // Runtimes from the start times (unsigned arithmetic: right across the millis() roll-over)
+    void updateTimers() {
+      uint32_t now = millis();
+      for (size_t i = 0; i < count_; i++) {
+        Pump &pump = pumps_[i];
+        pump.runningSec = pump.powered ? (now - pump.startedMs) / 1000 : 0;
+      }
+    }
+
+    // One pass over all the pumps: decide from each pump's own inputs, then apply
+    void evaluate(MasterMode mode) {
+      uint32_t now = millis();
+      for (size_t i = 0; i < count_; i++) {
+        Pump &pump = pumps_[i];
+        if (!pump.config.enabled) continue;
+        PumpInputs inputs;
+        inputs.mode = mode;
+        inputs.state = pump.state;
+        inputs.waterDistanceCm = pump.config.waterDistanceCm ? *pump.config.waterDistanceCm : NAN;   // No sensor: invalid measure
+        inputs.runningMinutes = pump.runningSec / 60.0f;
+        inputs.cooldownMinutes = (now - pump.cooldownStartMs) / 60000.0f;
+        pump.decision = decidePump(inputs, pump.config.policy);
+        if (pump.decision.next == PumpState::Cooldown && pump.state != PumpState::Cooldown) pump.cooldownStartMs = now;
+        pump.previous = pump.state;
+        pump.state = pump.decision.next;
+        setPower(i, pump.decision.powered);
+      }
+    }
+
+    bool anyPowered() const {
+      for (size_t i = 0; i < count_; i++)
+        if (pumps_[i].powered) return true;
+      return false;
+    }
+
+    // Bit i set: pump i powered
+    uint32_t poweredMask() const {
+      uint32_t mask = 0;
+      for (size_t i = 0; i < count_; i++)
+        if (pumps_[i].powered) mask |= 1UL << i;
+      return mask;
+    }
+
+    size_t count() const { return count_; }
+    Pump &operator[](int id) { return pumps_[id]; }
+    const Pump &operator[](int id) const { return pumps_[id]; }
+
+  private:
+    static void writeRelay(const Pump &pump, bool on) {
+      digitalWrite(pump.config.relayPin, on ? LOW : HIGH);
+      digitalWrite(pump.config.ledPin, on ? HIGH : LOW);
+    }
+
+    Pump pumps_[N];
+    size_t count_ = 0;
+    PowerHook powerHook_ = nullptr;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+// PUMP DECISION
+// -------------
+// The pump decision as a pure function: an immutable snapshot of the inputs
+// (mode, pump state, filtered measure, timers) and the policy (thresholds) in,
+// the decision out, with its reason code. No globals, no clock, no I/O: the
+// firmware applies the decision (relays, telemetry, texts), the host replay
+// (program --decisions) runs it over weeks of synthetic measures.
+//
+// Table driven: every rule is evaluated (no early exit), each one sets its bit,
+// and the first rule matching in priority order (pumpRulePriority) gives the
+// event; the state machine (pump_state_machine.h) does the rest.
+//
+//   PumpDecision decision = decidePump(inputs, policy);
+//   decision.powered;      // Relay
+//   decision.reason;       // PumpEvent, e.g. PumpEvent::WaterLow
+//   decision.analysis;     // "Water TOO LOW to pump"
+
+#include <stdint.h>
+#include "pump_state_machine.h"
+
+struct PumpPolicy {
+  float validDistanceMinCm;       // Measures outside [min, max] are unrealistic (sensor issue)
+  float validDistanceMaxCm;
+  float minimumWaterLevelCm;      // Enough water to pump when the sensor-to-water distance is below this
+  float maxRuntimeMinutes;        // Overheat protection: longest run...
+  float cooldownMinutes;          // ...then the pump rests that long
+};
+
+struct PumpInputs {
+  MasterMode mode;
+  PumpState state;
+  float waterDistanceCm;          // Filtered sensor-to-water distance
+  float runningMinutes;           // Since the pump started (state Running)
+  float cooldownMinutes;          // Since the cooldown started (state Cooldown)
+};
+
+struct PumpDecision {
+  PumpEvent reason;
+  PumpState next;
+  bool powered;
+  const char *analysis;
+};
+
+// Rules by priority: forced modes first, then the measure must be valid, then
+// there must be enough water, then the overheat protection has its say
+constexpr PumpEvent pumpRulePriority[] = {
+  PumpEvent::ForcedOn,
+  PumpEvent::ForcedOff,
+  PumpEvent::InvalidMeasure,
+  PumpEvent::WaterLow,
+  PumpEvent::RunTooLong,
+  PumpEvent::CooldownOver,
+  PumpEvent::WaterOk,           // Always matches: the default
+};
+constexpr int PUMP_RULES_COUNT = sizeof(pumpRulePriority) / sizeof(pumpRulePriority[0]);
+
+inline PumpDecision decidePump(const PumpInputs &in, const PumpPolicy &policy) {
+  // One bit per rule, same order as pumpRulePriority
+  bool validMeasure = in.waterDistanceCm >= policy.validDistanceMinCm && in.waterDistanceCm <= policy.validDistanceMaxCm;  // False for NaN
+  uint32_t matches = (uint32_t)(in.mode == MasterMode::ForcedOn)
+                     | (uint32_t)(in.mode == MasterMode::ForcedOff) << 1
+                     | (uint32_t)!validMeasure << 2
+                     | (uint32_t)(in.waterDistanceCm >= policy.minimumWaterLevelCm) << 3
+                     | (uint32_t)(in.state == PumpState::Running && in.runningMinutes > policy.maxRuntimeMinutes) << 4
+                     | (uint32_t)(in.state == PumpState::Cooldown && in.cooldownMinutes >= policy.cooldownMinutes) << 5
+                     | 1u << 6;
+  PumpEvent reason = pumpRulePriority[__builtin_ctz(matches)];
+  const PumpTransition &transition = pumpTransition(in.state, reason);
+  return { reason, transition.next, pumpPowered(transition.next), transition.analysis };
+}
+
+namespace pump_decision_detail {
+  // Every event is exactly one rule, WaterOk (the default) last
+  constexpr bool rulesCoverEvents() {
+    for (int e = 0; e < PUMP_EVENT_COUNT; e++) {
+      int found = 0;
+      for (int r = 0; r < PUMP_RULES_COUNT; r++) found += pumpRulePriority[r] == (PumpEvent)e;
+      if (found != 1) return false;
+    }
+    return pumpRulePriority[PUMP_RULES_COUNT - 1] == PumpEvent::WaterOk;
+  }
+}
+static_assert(PUMP_RULES_COUNT == PUMP_EVENT_COUNT && pump_decision_detail::rulesCoverEvents(), "pumpRulePriority: one rule per PumpEvent, WaterOk last");
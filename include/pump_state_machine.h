@@ -0,0 +1,134 @@
+#pragma once
+
+// PUMP STATE MACHINE
+// ------------------
+// Operating mode, pump state and overheat protection as small enums: the
+// decision logic only compares integers, the names ("AUTO", "FORCED ON"...)
+// are only used at the edges (web page, OLED, Serial, NVS migration).
+//
+// Each analysis turns the measures into one PumpEvent, the transition table
+// gives the next PumpState (and the analysis text to show):
+//
+//   PumpState next = nextPumpState(state, PumpEvent::WaterOk);
+//   pumpTransition(state, event).analysis;     // "OK to pump!"
+//
+// The whole table is checked at compile time (see the static_asserts below).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// MASTER (OPERATIONS) MODE
+enum class MasterMode : uint8_t { Auto, ForcedOff, ForcedOn };
+constexpr int MASTER_MODE_COUNT = 3;
+
+// Display names (web page, OLED, Serial), and the /mastermode?mode= parameter values
+constexpr const char *masterModeNames[MASTER_MODE_COUNT] = { "AUTO", "FORCED OFF", "FORCED ON" };
+constexpr const char *masterModeParams[MASTER_MODE_COUNT] = { "auto", "off", "on" };
+
+inline const char *masterModeName(MasterMode mode) {
+  return masterModeNames[(uint8_t)mode];
+}
+constexpr bool isValidMasterMode(uint8_t code) {
+  return code < MASTER_MODE_COUNT;
+}
+// From a name (table given: masterModeNames or masterModeParams), false if unknown
+inline bool parseMasterMode(const char *text, const char *const *names, MasterMode &mode) {
+  for (uint8_t i = 0; i < MASTER_MODE_COUNT; i++) {
+    if (strcmp(text, names[i]) == 0) {
+      mode = (MasterMode)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// PUMP STATE
+// Cooldown: overheat protection, the pump is off until it has rested long enough
+enum class PumpState : uint8_t { Off, Running, Cooldown };
+constexpr int PUMP_STATE_COUNT = 3;
+constexpr const char *pumpStateNames[PUMP_STATE_COUNT] = { "OFF", "RUNNING", "COOLDOWN" };
+
+// What an analysis concluded from the mode and the measures
+enum class PumpEvent : uint8_t {
+  ForcedOn,             // Master mode FORCED ON
+  ForcedOff,            // Master mode FORCED OFF
+  InvalidMeasure,       // Unrealistic sensor value: we don't know if there is water
+  WaterLow,             // Not enough water to pump
+  WaterOk,              // Enough water to pump
+  RunTooLong,           // Enough water, but running for longer than the overheat limit
+  CooldownOver,         // Enough water, and rested long enough after an overheat
+};
+constexpr int PUMP_EVENT_COUNT = 7;
+constexpr const char *pumpEventNames[PUMP_EVENT_COUNT] = {
+  "FORCED_ON", "FORCED_OFF", "INVALID_MEASURE", "WATER_LOW", "WATER_OK", "RUN_TOO_LONG", "COOLDOWN_OVER"
+};
+
+struct PumpTransition {
+  PumpState next;
+  const char *analysis;           // systemAnalysis text
+};
+
+namespace pump_state_machine_detail {
+  constexpr PumpState OFF = PumpState::Off;
+  constexpr PumpState RUN = PumpState::Running;
+  constexpr PumpState COOL = PumpState::Cooldown;
+
+  // [state][event], events in PumpEvent order
+  constexpr PumpTransition transitions[PUMP_STATE_COUNT][PUMP_EVENT_COUNT] = {
+    // Off
+    { {RUN, "Pump FORCED ON"}, {OFF, "Pump FORCED OFF"}, {OFF, "Invalid measure!"}, {OFF, "Water TOO LOW to pump"},
+      {RUN, "OK to pump!"}, {RUN, "OK to pump!"}, {RUN, "OK to pump!"} },
+    // Running
+    { {RUN, "Pump FORCED ON"}, {OFF, "Pump FORCED OFF"}, {OFF, "Invalid measure!"}, {OFF, "Water TOO LOW to pump"},
+      {RUN, "OK to pump!"}, {COOL, "Overheat protection activated"}, {RUN, "OK to pump!"} },
+    // Cooldown: only the forced modes or the end of the cooldown leave it
+    { {RUN, "Pump FORCED ON"}, {OFF, "Pump FORCED OFF"}, {COOL, "Invalid measure!"}, {COOL, "Water TOO LOW to pump"},
+      {COOL, "Overheat protection activated"}, {COOL, "Overheat protection activated"}, {RUN, "Overheat protection ended"} },
+  };
+}
+
+constexpr const PumpTransition &pumpTransition(PumpState state, PumpEvent event) {
+  return pump_state_machine_detail::transitions[(uint8_t)state][(uint8_t)event];
+}
+constexpr PumpState nextPumpState(PumpState state, PumpEvent event) {
+  return pumpTransition(state, event).next;
+}
+constexpr bool pumpPowered(PumpState state) {
+  return state == PumpState::Running;
+}
+
+// Exhaustive checks of the table (every state x event)
+namespace pump_state_machine_detail {
+  constexpr bool forAll(bool (*check)(PumpState, PumpEvent)) {
+    for (int s = 0; s < PUMP_STATE_COUNT; s++)
+      for (int e = 0; e < PUMP_EVENT_COUNT; e++)
+        if (!check((PumpState)s, (PumpEvent)e)) return false;
+    return true;
+  }
+  // The forced modes win whatever the state (and end any overheat protection)
+  constexpr bool forcedModesWin(PumpState s, PumpEvent e) {
+    return (e != PumpEvent::ForcedOn || nextPumpState(s, e) == RUN) && (e != PumpEvent::ForcedOff || nextPumpState(s, e) == OFF);
+  }
+  // The pump never runs without enough water (unless forced)
+  constexpr bool noRunWithoutWater(PumpState s, PumpEvent e) {
+    return !(e == PumpEvent::InvalidMeasure || e == PumpEvent::WaterLow || e == PumpEvent::ForcedOff) || !pumpPowered(nextPumpState(s, e));
+  }
+  // Only running too long starts a cooldown
+  constexpr bool cooldownOnlyAfterOverheat(PumpState s, PumpEvent e) {
+    return s == COOL || nextPumpState(s, e) != COOL || (s == RUN && e == PumpEvent::RunTooLong);
+  }
+  // A cooldown is only left when it is over, or by the forced modes
+  constexpr bool cooldownKept(PumpState s, PumpEvent e) {
+    return s != COOL || nextPumpState(s, e) == COOL || e == PumpEvent::CooldownOver || e == PumpEvent::ForcedOn || e == PumpEvent::ForcedOff;
+  }
+  constexpr bool hasAnalysis(PumpState s, PumpEvent e) {
+    return pumpTransition(s, e).analysis != nullptr && pumpTransition(s, e).analysis[0] != '\0';
+  }
+}
+
+static_assert(pump_state_machine_detail::forAll(pump_state_machine_detail::forcedModesWin), "PumpState: forced modes must always apply");
+static_assert(pump_state_machine_detail::forAll(pump_state_machine_detail::noRunWithoutWater), "PumpState: pump running without enough water");
+static_assert(pump_state_machine_detail::forAll(pump_state_machine_detail::cooldownOnlyAfterOverheat), "PumpState: cooldown entered without overheat");
+static_assert(pump_state_machine_detail::forAll(pump_state_machine_detail::cooldownKept), "PumpState: cooldown left before its end");
+static_assert(pump_state_machine_detail::forAll(pump_state_machine_detail::hasAnalysis), "PumpState: transition without analysis text");
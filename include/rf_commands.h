@@ -0,0 +1,197 @@
+#pragma once
+
+// RF433 COMMANDS
+// --------------
+// What a received 433Mhz code means: a command name and the action it triggers.
+//
+// - Built-in remotes: a constexpr table, hashed at compile time with a perfect
+//   hash (a multiplier is searched until no two codes share a slot). A lookup is
+//   one multiply, one shift and one compare, whatever the number of codes.
+// - Learned remotes: codes bound to an action at run time (web /learn), kept in
+//   NVS as one blob. Open addressing (linear probing) over a table twice the size
+//   of the codes, so a lookup stays O(1) with hundreds of codes.
+//
+//   constexpr RfCommand remotes[] = { { 4195665, "PH2-A-ON", RfAction::PumpsOn }, ... };
+//   constexpr RfCommandTable builtIn(remotes);
+//   static_assert(builtIn.valid(), "...");
+//   const RfCommand *command = builtIn.find(code);      // nullptr: unknown code
+//
+//   LearnedRemotes<256> learned;
+//   learned.load(preferences, "rfLearned");
+//   learned.learn(code, RfAction::PumpsOff, preferences, "rfLearned");   // Saved right away (rare)
+//   const auto *entry = learned.find(code);              // nullptr: not learned
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "hal.h"
+
+enum class RfAction : uint8_t {
+  None,           // Known code, nothing to do (name only)
+  PumpsOn,        // Master mode FORCED ON
+  PumpsOff,       // Master mode FORCED OFF
+  PumpsAuto,      // Master mode AUTO
+};
+constexpr int RF_ACTION_COUNT = 4;
+constexpr const char *rfActionNames[RF_ACTION_COUNT] = { "none", "on", "off", "auto" };   // Web parameters too
+
+inline bool parseRfAction(const char *name, RfAction &action) {
+  for (int i = 0; i < RF_ACTION_COUNT; i++) {
+    if (strcmp(name, rfActionNames[i]) == 0) {
+      action = (RfAction)i;
+      return true;
+    }
+  }
+  return false;
+}
+
+struct RfCommand {
+  uint32_t code;
+  const char *name;
+  RfAction action;
+};
+
+// Multiplicative hash: the top bits of code * multiplier
+constexpr uint32_t rfHashSlot(uint32_t code, uint32_t multiplier, int bits) {
+  return (uint32_t)(code * multiplier) >> (32 - bits);
+}
+
+template <size_t N>
+class RfCommandTable {
+  public:
+    static constexpr int BITS = N * 2 <= 2 ? 1 : 32 - __builtin_clz((uint32_t)(N * 2 - 1));   // At least twice N slots
+    static constexpr size_t SLOTS = (size_t)1 << BITS;
+
+    constexpr RfCommandTable(const RfCommand (&commands)[N]) : commands_(), slots_(), multiplier_(0) {
+      for (size_t i = 0; i < N; i++) commands_[i] = commands[i];
+      // Odd multipliers from the golden ratio one onwards, the first without collision wins
+      for (uint32_t candidate = 2654435761u, tries = 0; tries < 10000; candidate += 2 * 40503u, tries++) {
+        if (place(candidate)) {
+          multiplier_ = candidate;
+          return;
+        }
+      }
+    }
+
+    // False when no perfect hash was found (or two commands have the same code)
+    constexpr bool valid() const { return multiplier_ != 0; }
+
+    constexpr const RfCommand *find(uint32_t code) const {
+      uint8_t slot = slots_[rfHashSlot(code, multiplier_, BITS)];
+      return slot && commands_[slot - 1].code == code ? &commands_[slot - 1] : nullptr;
+    }
+
+    static constexpr size_t size() { return N; }
+    constexpr const RfCommand &operator[](size_t i) const { return commands_[i]; }
+
+  private:
+    constexpr bool place(uint32_t multiplier) {
+      for (size_t s = 0; s < SLOTS; s++) slots_[s] = 0;
+      for (size_t i = 0; i < N; i++) {
+        uint32_t s = rfHashSlot(commands_[i].code, multiplier, BITS);
+        if (slots_[s]) return false;
+        slots_[s] = i + 1;
+      }
+      return true;
+    }
+
+    static_assert(N > 0 && N < 255, "RfCommandTable: 1..254 commands");
+    RfCommand commands_[N];
+    uint8_t slots_[SLOTS];            // Command index + 1, 0: empty
+    uint32_t multiplier_;
+};
+
+template <size_t N>
+class LearnedRemotes {
+  static_assert(N > 0 && N < 65535, "LearnedRemotes: at most 65534 codes");
+
+  public:
+    struct Entry {
+      uint32_t code;
+      RfAction action;
+      uint8_t reserved[3];            // No padding: the entries are the NVS blob, byte for byte
+    };
+
+    // Boot: false when nothing was learned yet
+    bool load(Preferences &preferences, const char *key) {
+      size_t bytes = preferences.getBytes(key, entries_, sizeof(entries_));
+      count_ = 0;
+      for (size_t i = 0; i < bytes / sizeof(Entry); i++) {
+        if ((uint8_t)entries_[i].action < RF_ACTION_COUNT) entries_[count_++] = entries_[i];
+      }
+      rebuildIndex();
+      return count_ > 0;
+    }
+
+    // Binds the code to the action (replaces its previous one) and saves the table.
+    // False when the table is full
+    bool learn(uint32_t code, RfAction action, Preferences &preferences, const char *key) {
+      int index = indexOf(code);
+      if (index < 0) {
+        if (count_ == N) return false;
+        index = count_++;
+        entries_[index] = {};
+        entries_[index].code = code;
+        insert(index);
+      }
+      entries_[index].action = action;
+      save(preferences, key);
+      return true;
+    }
+
+    bool forget(uint32_t code, Preferences &preferences, const char *key) {
+      int index = indexOf(code);
+      if (index < 0) return false;
+      entries_[index] = entries_[--count_];
+      rebuildIndex();                 // Rare: simpler than deleting from the probe sequence
+      save(preferences, key);
+      return true;
+    }
+
+    void clear(Preferences &preferences, const char *key) {
+      count_ = 0;
+      rebuildIndex();
+      save(preferences, key);
+    }
+
+    const Entry *find(uint32_t code) const {
+      int index = indexOf(code);
+      return index < 0 ? nullptr : &entries_[index];
+    }
+
+    size_t count() const { return count_; }
+    static constexpr size_t capacity() { return N; }
+    const Entry &operator[](size_t i) const { return entries_[i]; }
+
+  private:
+    static constexpr int BITS = 32 - __builtin_clz((uint32_t)(N * 2 - 1));
+    static constexpr size_t SLOTS = (size_t)1 << BITS;
+
+    int indexOf(uint32_t code) const {
+      for (uint32_t s = rfHashSlot(code, 2654435761u, BITS);; s = (s + 1) & (SLOTS - 1)) {
+        uint16_t slot = slots_[s];
+        if (slot == 0) return -1;     // Never full: at least half of the slots are empty
+        if (entries_[slot - 1].code == code) return slot - 1;
+      }
+    }
+
+    void insert(int index) {
+      uint32_t s = rfHashSlot(entries_[index].code, 2654435761u, BITS);
+      while (slots_[s]) s = (s + 1) & (SLOTS - 1);
+      slots_[s] = index + 1;
+    }
+
+    void rebuildIndex() {
+      memset(slots_, 0, sizeof(slots_));
+      for (size_t i = 0; i < count_; i++) insert(i);
+    }
+
+    void save(Preferences &preferences, const char *key) {
+      if (count_ == 0) preferences.remove(key);
+      else preferences.putBytes(key, entries_, count_ * sizeof(Entry));
+    }
+
+    Entry entries_[N];
+    uint16_t slots_[SLOTS] = {};      // Entry index + 1, 0: empty
+    size_t count_ = 0;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+// 433MHZ TRANSMIT QUEUE
+// ---------------------
+// Codes waiting to be sent over 433Mhz. Callers (loop(), web handlers...) only
+// queue codes and return immediately, a background task sends them one by one.
+//
+// - Highest priority first, first-in first-out for the same priority.
+// - A code identical to one already pending is not queued twice (the pending
+//   one just gets the highest of both priorities).
+// - When full, the lowest priority (then oldest) pending code makes room for a
+//   higher priority one, otherwise the new code is dropped.
+//
+// Only a handful of codes are ever pending, so a small array scanned linearly
+// is the fastest "priority queue" here. Protected by a critical section since
+// producers and the sender run in different tasks.
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hal.h"
+
+template <size_t N>
+class RfTxQueue {
+  public:
+    // Returns false if the code was dropped (queue full of higher priority codes)
+    bool push(uint32_t code, uint8_t priority) {
+      bool accepted = true;
+      portENTER_CRITICAL(&mux_);
+      int found = find(code);
+      if (found >= 0) {
+        if (priority > entries_[found].priority) entries_[found].priority = priority;
+        deduplicated_++;
+      } else {
+        if (count_ == N) {
+          int lowest = selectLowest();
+          if (entries_[lowest].priority < priority) {
+            entries_[lowest] = entries_[--count_];
+            dropped_++;
+          } else {
+            accepted = false;
+            dropped_++;
+          }
+        }
+        if (accepted) {
+          entries_[count_++] = {code, priority, sequence_++};
+          queued_++;
+        }
+      }
+      portEXIT_CRITICAL(&mux_);
+      return accepted;
+    }
+
+    // Returns false if nothing is pending
+    bool pop(uint32_t &code) {
+      bool available = false;
+      portENTER_CRITICAL(&mux_);
+      if (count_ > 0) {
+        int highest = selectHighest();
+        code = entries_[highest].code;
+        entries_[highest] = entries_[--count_];
+        available = true;
+      }
+      portEXIT_CRITICAL(&mux_);
+      return available;
+    }
+
+    size_t pending() const { return count_; }
+    uint32_t queued() const { return queued_; }
+    uint32_t deduplicated() const { return deduplicated_; }
+    uint32_t dropped() const { return dropped_; }
+
+  private:
+    struct Entry {
+      uint32_t code;
+      uint8_t priority;
+      uint32_t sequence;      // Arrival order
+    };
+
+    int find(uint32_t code) const {
+      for (size_t i = 0; i < count_; i++) {
+        if (entries_[i].code == code) return i;
+      }
+      return -1;
+    }
+    // Highest priority, oldest first
+    int selectHighest() const {
+      int best = 0;
+      for (size_t i = 1; i < count_; i++) {
+        if (entries_[i].priority > entries_[best].priority
+            || (entries_[i].priority == entries_[best].priority && (int32_t)(entries_[i].sequence - entries_[best].sequence) < 0)) best = i;
+      }
+      return best;
+    }
+    // Lowest priority, oldest first
+    int selectLowest() const {
+      int worst = 0;
+      for (size_t i = 1; i < count_; i++) {
+        if (entries_[i].priority < entries_[worst].priority
+            || (entries_[i].priority == entries_[worst].priority && (int32_t)(entries_[i].sequence - entries_[worst].sequence) < 0)) worst = i;
+      }
+      return worst;
+    }
+
+    Entry entries_[N];
+    size_t count_ = 0;
+    uint32_t sequence_ = 0;
+    uint32_t queued_ = 0, deduplicated_ = 0, dropped_ = 0;
+    portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+};
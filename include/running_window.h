@@ -0,0 +1,91 @@
+#pragma once
+
+// RUNNING WINDOW
+// --------------
+// Ring buffer of the last N measures keeping a running sum and sum of squares,
+// so mean() and variance() are O(1) per new measure instead of re-summing the
+// whole window.
+//
+// Adding the new value and removing the oldest one on every push makes float
+// rounding errors pile up over time, so:
+// - sums are updated with Kahan compensated additions
+// - every N pushes, sums are recomputed from scratch (amortized O(1)) which
+//   bounds the drift to what can accumulate within a single window
+// - sums are kept relative to a shift (a recent measure, chosen again at each
+//   resync): with ~30cm measures and mm of noise, sumSq/n - mean^2 on the raw
+//   values would cancel out most of the float digits.
+//
+// The values can also be altered in place through values() (e.g. TopKAverage),
+// call resync() afterwards so the sums match the new content.
+
+#include <stddef.h>
+
+template <size_t N>
+class RunningWindow {
+  static_assert(N > 0, "RunningWindow: N must be > 0");
+
+  public:
+    // Add a measure, replacing the oldest one once the window is full
+    void push(float value) {
+      if (count_ == 0) shift_ = value;
+      float oldest = full() ? values_[next_] - shift_ : 0.0;
+      values_[next_] = value;
+      next_ = (next_ + 1) % N;
+      if (count_ < N) count_++;
+      if (++pushesSinceResync_ >= N) {
+        resync();
+      } else {
+        float shifted = value - shift_;
+        kahanAdd(sum_, sumC_, shifted - oldest);
+        kahanAdd(sumSq_, sumSqC_, shifted * shifted - oldest * oldest);
+      }
+    }
+
+    // Recompute the sums from the values (exact, O(N))
+    void resync() {
+      sum_ = sumC_ = sumSq_ = sumSqC_ = 0.0;
+      if (count_ > 0) shift_ = values_[(next_ + N - 1) % N];   // Newest measure
+      for (size_t i = 0; i < count_; i++) {
+        float shifted = values_[i] - shift_;
+        kahanAdd(sum_, sumC_, shifted);
+        kahanAdd(sumSq_, sumSqC_, shifted * shifted);
+      }
+      pushesSinceResync_ = 0;
+    }
+
+    void clear() {
+      count_ = next_ = pushesSinceResync_ = 0;
+      sum_ = sumC_ = sumSq_ = sumSqC_ = shift_ = 0.0;
+    }
+
+    size_t count() const { return count_; }
+    bool full() const { return count_ == N; }
+    static constexpr size_t capacity() { return N; }
+    float (&values())[N] { return values_; }
+
+    float sum() const { return shift_ * count_ + sum_; }
+    float mean() const { return count_ ? shift_ + sum_ / count_ : 0.0; }
+    // Population variance, never negative even with rounding errors
+    float variance() const {
+      if (!count_) return 0.0;
+      float m = sum_ / count_;                // Shifted mean
+      float v = sumSq_ / count_ - m * m;
+      return v > 0.0 ? v : 0.0;
+    }
+
+  private:
+    static void kahanAdd(float &sum, float &compensation, float value) {
+      float y = value - compensation;
+      float t = sum + y;
+      compensation = (t - sum) - y;
+      sum = t;
+    }
+
+    float values_[N] = {0};
+    size_t count_ = 0;
+    size_t next_ = 0;                 // Where the next measure goes (the oldest one when full)
+    size_t pushesSinceResync_ = 0;
+    float shift_ = 0.0;               // Subtracted from the values before they are summed
+    float sum_ = 0.0, sumC_ = 0.0;    // Running sum and its Kahan compensation
+    float sumSq_ = 0.0, sumSqC_ = 0.0;
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+// SENSOR FILTERS
+// --------------
+// Noise reduction for the Klong distance sensors, built as a chain of stages
+// composed at compile time, e.g.:
+//
+//   typedef FilterChain<HampelFilter<15, 30>, EmaFilter<20>> MySensorFilter;
+//
+// Every stage has a fixed memory footprint (no heap) and the same interface:
+//
+//   bool process(float in, float &out)   Returns false while the stage is still
+//                                        settling (out is then left untouched)
+//   void reset()                         Back to the initial (settling) state
+//   uint32_t rejected()                  Measures replaced so far (outliers), not reset
+//
+// A chain returns false as long as any of its stages is settling, so there is
+// no magic value to check: either there is a valid filtered measure, or not yet.
+//
+// Template parameters are integers (floats can't be template parameters), so
+// ratios are expressed in percent, permille or tenths as stated for each stage.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+#include "running_window.h"
+#include "topk_average.h"
+
+// Median of N values (assumes N small, the values are copied to the stack)
+template <size_t N>
+float medianOf(const float (&values)[N]) {
+  float work[N];
+  std::copy(values, values + N, work);
+  std::nth_element(work, work + N / 2, work + N);
+  return work[N / 2];
+}
+
+// MEDIAN OF N
+// Outputs the median of the last N measures. Settles after N measures.
+template <size_t N>
+class MedianFilter {
+  public:
+    bool process(float in, float &out) {
+      values_[next_] = in;
+      next_ = (next_ + 1) % N;
+      if (count_ < N) count_++;
+      if (count_ < N) return false;
+      out = medianOf(values_);
+      return true;
+    }
+    void reset() { count_ = next_ = 0; }
+    uint32_t rejected() const { return 0; }
+  private:
+    float values_[N];
+    size_t count_ = 0, next_ = 0;
+};
+
+// EXPONENTIAL MOVING AVERAGE
+// out = alpha * in + (1 - alpha) * previous out, alpha given in percent.
+// Settles on the first measure.
+template <int AlphaPercent>
+class EmaFilter {
+  static_assert(AlphaPercent > 0 && AlphaPercent <= 100, "EmaFilter: alpha must be within 1..100%");
+  public:
+    bool process(float in, float &out) {
+      value_ = started_ ? value_ + (in - value_) * (AlphaPercent / 100.0f) : in;
+      started_ = true;
+      out = value_;
+      return true;
+    }
+    void reset() { started_ = false; }
+    uint32_t rejected() const { return 0; }
+  private:
+    float value_ = 0.0;
+    bool started_ = false;
+};
+
+// HAMPEL OUTLIER REJECTION
+// A new measure further than (threshold x 1.4826 x MAD) from the median of the
+// last N measures is replaced by that median, threshold given in tenths (30 = 3.0).
+// Settles after N measures.
+template <size_t N, int ThresholdTenths>
+class HampelFilter {
+  public:
+    bool process(float in, float &out) {
+      if (count_ < N) {
+        values_[count_++] = in;
+        return false;
+      }
+      float median = medianOf(values_);
+      float deviations[N];
+      for (size_t i = 0; i < N; i++) deviations[i] = fabsf(values_[i] - median);
+      float mad = medianOf(deviations);
+      bool outlier = fabsf(in - median) > (ThresholdTenths / 10.0f) * 1.4826f * mad;
+      values_[next_] = in;
+      next_ = (next_ + 1) % N;
+      out = outlier ? median : in;
+      if (outlier) rejected_++;
+      return true;
+    }
+    void reset() { count_ = next_ = 0; }
+    uint32_t rejected() const { return rejected_; }
+  private:
+    float values_[N];
+    size_t count_ = 0, next_ = 0;
+    uint32_t rejected_ = 0;
+};
+
+// TOP-K AVERAGE WITH ACCEPTANCE BAND (original DMZ controller logic)
+// - The first N measures are collected, then the K highest are kept and all the
+//   others replaced by their average (TopKAverage) to build a baseline.
+// - From then on, a new measure within +/- band (permille) of the window average is
+//   added to the window, otherwise the average itself is added instead.
+// - The output is always the window average.
+// Settles after N measures.
+template <size_t N, size_t K, int BandPermille>
+class TopKBandFilter {
+  public:
+    bool process(float in, float &out) {
+      if (!seeded_) {
+        if (!window_.full()) {
+          window_.push(in);
+          return false;
+        }
+        seeded_ = true;
+        out = TopKAverage<N, K>::apply(window_.values());
+        window_.resync();
+        window_.push(out);
+        return true;
+      }
+      float avg = window_.mean();
+      float deviation = (in - avg) / avg;
+      bool outOfBand = deviation < -(BandPermille / 1000.0f) || deviation > (BandPermille / 1000.0f);
+      window_.push(outOfBand ? avg : in);
+      if (outOfBand) rejected_++;
+      out = avg;
+      return true;
+    }
+    void reset() {
+      window_.clear();
+      seeded_ = false;
+    }
+    uint32_t rejected() const { return rejected_; }
+  private:
+    RunningWindow<N> window_;
+    bool seeded_ = false;
+    uint32_t rejected_ = 0;
+};
+
+// FILTER CHAIN
+// Runs the stages in order, the output of one stage is the input of the next one.
+template <typename... Stages>
+class FilterChain;
+
+template <>
+class FilterChain<> {
+  public:
+    bool process(float in, float &out) {
+      out = in;
+      return true;
+    }
+    void reset() {}
+    uint32_t rejected() const { return 0; }
+};
+
+template <typename First, typename... Rest>
+class FilterChain<First, Rest...> {
+  public:
+    bool process(float in, float &out) {
+      float stageOut;
+      if (!first_.process(in, stageOut)) return false;
+      return rest_.process(stageOut, out);
+    }
+    void reset() {
+      first_.reset();
+      rest_.reset();
+    }
+    uint32_t rejected() const { return first_.rejected() + rest_.rejected(); }
+  private:
+    First first_;
+    FilterChain<Rest...> rest_;
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+// SETTINGS STORE
+// --------------
+// Settings live in RAM and NVS is only written once they have settled:
+// - set() keeps the new values (from any task), nothing happens if nothing changed,
+// - commitIfDue() (loop side) writes them debounceMs after the last change, so a
+//   burst of clicks / web requests ends up as a single flash write, and a value
+//   changed then changed back before that is not written at all,
+// - all the settings go in one packed blob (a single putBytes), together with a
+//   lifetime write counter for flash wear monitoring.
+//
+//   SettingsStore<Settings> store(preferences, "settings", 2000, 1);
+//   if (!store.load(settings)) { ...defaults... }
+//   store.set(settings);                   // Web handler, button...
+//   uint32_t waitMs = store.commitIfDue(); // loop(): 0 when nothing is pending anymore
+//
+// T must be a plain struct without padding (compared and stored byte for byte).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include "hal.h"
+
+template <typename T>
+class SettingsStore {
+  static_assert(std::is_trivially_copyable<T>::value, "SettingsStore: settings must be a plain struct");
+  static_assert(std::has_unique_object_representations<T>::value, "SettingsStore: settings must not have padding bytes");
+
+  public:
+    // layoutVersion: change it whenever T changes, an older blob is then ignored by load()
+    SettingsStore(Preferences &preferences, const char *key, uint32_t debounceMs, uint16_t layoutVersion)
+      : preferences_(preferences), key_(key), debounceMs_(debounceMs), layoutVersion_(layoutVersion) {}
+
+    // Boot: returns false (settings untouched) when there is no blob yet, or one of another layout
+    bool load(T &settings) {
+      Blob blob;
+      if (preferences_.getBytes(key_, &blob, sizeof(blob)) != sizeof(blob) || blob.layoutVersion != layoutVersion_) return false;
+      settings = blob.settings;
+      committed_ = pending_ = blob.settings;
+      lifetimeWrites_ = blob.writes;
+      stored_ = true;
+      return true;
+    }
+
+    // Any task: returns true when something changed (a write is pending)
+    bool set(const T &settings) {
+      portENTER_CRITICAL(&mux_);
+      bool changed = !(stored_ || dirty_) || memcmp(&settings, &pending_, sizeof(T)) != 0;
+      if (changed) {
+        pending_ = settings;
+        dirty_ = true;
+        lastChangeMs_ = millis();
+        changes_++;
+      }
+      portEXIT_CRITICAL(&mux_);
+      return changed;
+    }
+
+    // loop() side: writes once the last change is debounceMs old. Returns 0 when
+    // nothing is pending anymore, otherwise how long to wait before calling it again
+    uint32_t commitIfDue() {
+      portENTER_CRITICAL(&mux_);
+      uint32_t elapsed = millis() - lastChangeMs_;
+      bool waiting = dirty_ && elapsed < debounceMs_;
+      bool due = dirty_ && !waiting;
+      portEXIT_CRITICAL(&mux_);
+      if (waiting) return debounceMs_ - elapsed;
+      if (due) commit();
+      return 0;
+    }
+
+    // Writes right away whatever is pending (before a reboot...)
+    void commit() {
+      Blob blob;
+      portENTER_CRITICAL(&mux_);
+      bool dirty = dirty_;
+      dirty_ = false;
+      blob.settings = pending_;
+      portEXIT_CRITICAL(&mux_);
+      if (!dirty) return;
+      if (stored_ && memcmp(&blob.settings, &committed_, sizeof(T)) == 0) {
+        skipped_++;                   // Changed back before the write
+        return;
+      }
+      blob.layoutVersion = layoutVersion_;
+      blob.reserved = 0;
+      blob.writes = lifetimeWrites_ + 1;
+      if (preferences_.putBytes(key_, &blob, sizeof(blob)) != sizeof(blob)) {
+        failures_++;
+        portENTER_CRITICAL(&mux_);
+        dirty_ = true;                // Retried on the next commitIfDue()
+        lastChangeMs_ = millis();
+        portEXIT_CRITICAL(&mux_);
+        return;
+      }
+      committed_ = blob.settings;
+      lifetimeWrites_ = blob.writes;
+      stored_ = true;
+      writes_++;
+    }
+
+    bool pending() const { return dirty_; }
+    uint32_t changes() const { return changes_; }          // set() calls that changed something
+    uint32_t writes() const { return writes_; }            // NVS writes since boot
+    uint32_t lifetimeWrites() const { return lifetimeWrites_; }
+    uint32_t skipped() const { return skipped_; }          // Pending changes reverted before being written
+    uint32_t failures() const { return failures_; }
+
+  private:
+    struct Blob {
+      uint16_t layoutVersion;
+      uint16_t reserved;
+      uint32_t writes;                // Lifetime writes of this blob (this one included)
+      T settings;
+    };
+
+    Preferences &preferences_;
+    const char *key_;
+    uint32_t debounceMs_;
+    uint16_t layoutVersion_;
+    T pending_ = {};                  // Latest values, written by the next commit
+    T committed_ = {};                // What NVS holds
+    bool stored_ = false;             // NVS holds a blob of this layout
+    volatile bool dirty_ = false;
+    uint32_t lastChangeMs_ = 0;
+    uint32_t changes_ = 0;
+    uint32_t writes_ = 0;
+    uint32_t lifetimeWrites_ = 0;
+    uint32_t skipped_ = 0;
+    uint32_t failures_ = 0;
+    portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+};
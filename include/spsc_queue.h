@@ -0,0 +1,55 @@
+#pragma once
+
+// SPSC QUEUE
+// ----------
+// Fixed capacity, lock-free, Single Producer / Single Consumer ring buffer.
+// Meant to pass data from a callback running in another task (e.g. the
+// ESP-NOW receive callback running in the WiFi task) to loop(), without
+// locks and without heap allocation.
+//
+// - push() must only be called by the producer, pop() only by the consumer.
+// - When the queue is full push() fails and the item is counted as dropped.
+// - N must be a power of 2, one slot is never used (N-1 usable items).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue: N must be a power of 2");
+
+  public:
+    // Producer side
+    bool push(const T &item) {
+      uint32_t head = head_.load(std::memory_order_relaxed);
+      uint32_t next = (head + 1) & (N - 1);
+      if (next == tail_.load(std::memory_order_acquire)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      items_[head] = item;
+      head_.store(next, std::memory_order_release);
+      return true;
+    }
+
+    // Consumer side
+    bool pop(T &item) {
+      uint32_t tail = tail_.load(std::memory_order_relaxed);
+      if (tail == head_.load(std::memory_order_acquire)) return false;
+      item = items_[tail];
+      tail_.store((tail + 1) & (N - 1), std::memory_order_release);
+      return true;
+    }
+
+    bool empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+    size_t size() const { return (head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire)) & (N - 1); }
+    static constexpr size_t capacity() { return N - 1; }
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    T items_[N];
+    std::atomic<uint32_t> head_{0};     // Next slot to write (producer)
+    std::atomic<uint32_t> tail_{0};     // Next slot to read (consumer)
+    std::atomic<uint32_t> dropped_{0};  // Items refused because the queue was full
+};
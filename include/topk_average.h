@@ -0,0 +1,34 @@
+#pragma once
+
+// TOP-K AVERAGE
+// -------------
+// Used to seed the measurements dataset: within a full window of N measures,
+// keep the K highest ones and replace all the others by the average of those K.
+//
+// The K highest are found with a selection (std::nth_element), so the cost is
+// O(N) on average whatever K is, and the window is processed in place (no copy).
+// The order of the measures in the window is NOT preserved, which is fine for
+// a dataset that is only used as a whole (sum/average).
+
+#include <stddef.h>
+#include <algorithm>
+
+template <size_t N, size_t K>
+struct TopKAverage {
+  static_assert(K > 0 && K <= N, "TopKAverage: K must be within 1..N");
+
+  // Returns the average of the K highest measures, window is updated in place
+  static float apply(float (&window)[N]) {
+    // After selection, window[N-K .. N-1] hold the K highest measures (unordered)
+    std::nth_element(window, window + (N - K), window + N);
+    float sum = 0.0;
+    for (size_t i = N - K; i < N; i++) {
+      sum += window[i];
+    }
+    float avg = sum / K;
+    for (size_t i = 0; i < N - K; i++) {
+      window[i] = avg;
+    }
+    return avg;
+  }
+};
@@ -0,0 +1,211 @@
+#pragma once
+
+// TRACE LOG
+// ---------
+// Deferred tracing instead of Serial.print() on the hot paths: at 115200 bauds
+// every printed line blocks its caller for milliseconds. A trace point only
+// writes a small binary record (event id, level, time, up to 4 arguments) into
+// a RAM ring, the text is formatted and printed later by whoever drains the
+// ring (a low priority background service on the ESP32, see main.cpp).
+//
+// - Lock-free, multiple producers (loop(), background services, web server and
+//   WiFi tasks), one consumer. When the ring is full the record is dropped and
+//   counted, a trace point never blocks.
+// - The event table (format string, or a formatter function) lives in the
+//   firmware: records are only decoded when drained.
+// - Arguments are integers, floats (stored as their bits) or strings that must
+//   outlive the record (literals, name tables): only the pointer is stored.
+// - Compile-time level filtering: trace points above TRACE_LEVEL are removed,
+//   arguments included (-DTRACE_LEVEL=TRACE_LEVEL_DEBUG for the 433Mhz raw pulses).
+//
+//   const TraceEventInfo traceEvents[] = { { "Packet %f cm from %u" } };
+//   TraceLog<64> traceLog;
+//   TRACE(TRACE_LEVEL_INFO, 0, distance, id);
+//   char line[128];
+//   while (traceLog.drain(traceEvents, 1, line, sizeof(line))) Serial.print(line);   // Consumer
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+#include "hal.h"
+
+#define TRACE_LEVEL_NONE  0
+#define TRACE_LEVEL_ERROR 1
+#define TRACE_LEVEL_WARN  2
+#define TRACE_LEVEL_INFO  3
+#define TRACE_LEVEL_DEBUG 4
+
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL TRACE_LEVEL_INFO
+#endif
+
+// Trace point: a no-op (arguments not even evaluated) when the level is filtered out
+#define TRACE(level, event, ...) do { if ((level) <= TRACE_LEVEL) traceLog.record((level), (event), ##__VA_ARGS__); } while (0)
+
+struct TraceRecord {
+  static const int MAX_ARGS = 4;
+  uint32_t timeMs;
+  uint16_t event;
+  uint8_t level;
+  uint8_t argCount;
+  uintptr_t args[MAX_ARGS];
+};
+
+// Formats a record into out (one line, '\n' included), instead of the format string
+typedef void (*TraceFormatter)(const TraceRecord &record, char *out, size_t size);
+
+struct TraceEventInfo {
+  const char *format;             // printf style: %d %u %x %f %s %c (flags and precision allowed)
+  TraceFormatter formatter = nullptr;   // Used instead of the format when set
+};
+
+// Record arguments: floats are kept as their bits, everything else as an integer / pointer
+inline uintptr_t traceArg(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+inline uintptr_t traceArg(double value) { return traceArg((float)value); }
+inline uintptr_t traceArg(const char *value) { return (uintptr_t)value; }
+template <typename T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, int>::type = 0>
+inline uintptr_t traceArg(T value) { return (uintptr_t)(intptr_t)value; }
+inline float traceArgFloat(uintptr_t arg) {
+  uint32_t bits = (uint32_t)arg;
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+template <size_t N>
+class TraceLog {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "TraceLog: N must be a power of 2");
+
+  public:
+    TraceLog() {
+      for (size_t i = 0; i < N; i++) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Producers (any task): a slot is claimed with a CAS on the write position, each cell's
+    // sequence number tells whether it is free, being written or ready to be drained
+    template <typename... Args>
+    bool record(uint8_t level, uint16_t event, Args... args) {
+      static_assert(sizeof...(Args) <= TraceRecord::MAX_ARGS, "TRACE: at most 4 arguments");
+      uint32_t position = writePosition_.load(std::memory_order_relaxed);
+      Cell *cell;
+      for (;;) {
+        cell = &cells_[position & (N - 1)];
+        int32_t difference = (int32_t)(cell->sequence.load(std::memory_order_acquire) - position);
+        if (difference == 0) {
+          if (writePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (difference < 0) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);   // Full: the drain is behind
+          return false;
+        } else {
+          position = writePosition_.load(std::memory_order_relaxed);
+        }
+      }
+      TraceRecord &r = cell->record;
+      r.timeMs = millis();
+      r.event = event;
+      r.level = level;
+      r.argCount = sizeof...(Args);
+      uintptr_t values[] = { traceArg(args)..., 0 };
+      memcpy(r.args, values, sizeof(uintptr_t) * sizeof...(Args));
+      cell->sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Consumer (one task only)
+    bool pop(TraceRecord &record) {
+      Cell &cell = cells_[readPosition_ & (N - 1)];
+      if (cell.sequence.load(std::memory_order_acquire) != readPosition_ + 1) return false;   // Empty (or still being written)
+      record = cell.record;
+      cell.sequence.store(readPosition_ + N, std::memory_order_release);
+      readPosition_++;
+      return true;
+    }
+
+    // Consumer: next record as a text line ("[  12.345] I text\n"). Records dropped since
+    // the last call are reported first. Returns false when there is nothing to print
+    bool drain(const TraceEventInfo *events, size_t eventCount, char *out, size_t size) {
+      uint32_t dropped = dropped_.load(std::memory_order_relaxed);
+      if (dropped != droppedReported_) {
+        snprintf(out, size, "[trace] %u records dropped\n", (unsigned)(dropped - droppedReported_));
+        droppedReported_ = dropped;
+        return true;
+      }
+      TraceRecord record;
+      if (!pop(record)) return false;
+      format(record, events, eventCount, out, size);
+      return true;
+    }
+
+    static void format(const TraceRecord &record, const TraceEventInfo *events, size_t eventCount, char *out, size_t size) {
+      static const char levels[] = "-EWID";
+      int n = snprintf(out, size, "[%6u.%03u] %c ", (unsigned)(record.timeMs / 1000), (unsigned)(record.timeMs % 1000),
+                       levels[record.level <= TRACE_LEVEL_DEBUG ? record.level : 0]);
+      if (n < 0 || (size_t)n >= size) return;
+      if (record.event >= eventCount) {
+        snprintf(out + n, size - n, "event %u\n", record.event);
+      } else if (events[record.event].formatter) {
+        events[record.event].formatter(record, out + n, size - n);
+      } else {
+        formatArgs(events[record.event].format, record, out + n, size - n);
+      }
+    }
+
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    static constexpr size_t capacity() { return N; }
+
+  private:
+    // printf, one conversion at a time (the arguments are untyped in the record)
+    static void formatArgs(const char *format, const TraceRecord &record, char *out, size_t size) {
+      size_t length = 0;
+      int arg = 0;
+      for (const char *p = format; *p && length + 1 < size;) {
+        if (*p != '%') {
+          out[length++] = *p++;
+          continue;
+        }
+        const char *start = p++;
+        while (*p && strchr("-+ #0123456789.l", *p)) p++;
+        if (!*p) break;
+        char spec[16];
+        size_t width = (size_t)(p - start) + 1;
+        size_t specLength = width < sizeof(spec) - 1 ? width : sizeof(spec) - 1;
+        memcpy(spec, start, specLength);
+        spec[specLength] = '\0';
+        char *l = strchr(spec, 'l');                    // Arguments are converted below, no length modifier
+        if (l) memmove(l, l + 1, strlen(l));
+        uintptr_t value = arg < record.argCount ? record.args[arg] : 0;
+        int n = 0;
+        switch (*p) {
+          case '%': n = snprintf(out + length, size - length, "%%"); arg--; break;
+          case 'd': case 'i': n = snprintf(out + length, size - length, spec, (int)(intptr_t)value); break;
+          case 'u': case 'x': case 'X': n = snprintf(out + length, size - length, spec, (unsigned)value); break;
+          case 'c': n = snprintf(out + length, size - length, spec, (int)value); break;
+          case 'f': n = snprintf(out + length, size - length, spec, (double)traceArgFloat(value)); break;
+          case 's': n = snprintf(out + length, size - length, spec, value ? (const char *)value : "(null)"); break;
+          default: n = 0; break;
+        }
+        p++;
+        arg++;
+        if (n > 0) length += (size_t)n < size - length ? n : size - length - 1;
+      }
+      if (length + 1 < size) out[length++] = '\n';
+      out[length] = '\0';
+    }
+
+    struct Cell {
+      std::atomic<uint32_t> sequence;
+      TraceRecord record;
+    };
+    Cell cells_[N];
+    std::atomic<uint32_t> writePosition_{0};
+    uint32_t readPosition_ = 0;                   // Consumer only
+    std::atomic<uint32_t> dropped_{0};
+    uint32_t droppedReported_ = 0;                // Consumer only
+};
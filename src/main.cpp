@@ -1,18 +1,18 @@
-#include <Arduino.h>
-#include <SPI.h>
-#include <Wire.h>
-#include <Preferences.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
-#include <RCSwitch.h>
-#include <AceButton.h>
-#include <esp_now.h>
-
-// Includes needed for OTA Updates (Over-The-Air updates)
-#include <WiFi.h>
-#include <AsyncTCP.h>
-#include <ESPAsyncWebServer.h>
-#include <AsyncElegantOTA.h>
+#include "hal.h"   // Arduino / ESP32 libraries (or their host simulation, see include/hal.h)
+#include "sensor_filters.h"
+#include "spsc_queue.h"
+#include "rf_tx_queue.h"
+#include "json_writer.h"
+#include "frequency_options.h"
+#include "oled_screen.h"
+#include "cooperative_scheduler.h"
+#include "settings_store.h"
+#include "pump_controller.h"
+#include "history_store.h"
+#include "history_stream.h"
+#include "metrics.h"
+#include "trace_log.h"
+#include "rf_commands.h"
 
 String  VERSION = "v2.63";
 String  DEVICE_NAME = "BKO-DMZ-CTL1";
@@ -57,6 +57,8 @@ String  DEVICE_NAME = "BKO-DMZ-CTL1";
 //
 // http://192.18.4.1/update            --> OTA - Over The Air firmware update
 // http://192.18.4.1/setmin?lvl=30     --> Set Sensor-To-Pump distance (cm) as threshold to enable the pump
+// http://192.18.4.1/metrics           --> Prometheus metrics (latencies, ESP-NOW packets, heap, stacks)
+// http://192.18.4.1/learn?action=off   --> Bind the next 433Mhz remote code received to pumps on / off / auto
 
 // BUTTON OPERATIONS
 //
@@ -80,6 +82,9 @@ String  DEVICE_NAME = "BKO-DMZ-CTL1";
 #define DATA_PACKET_DATATYPE_WLVL     2   // Water Level
 // DATA VALUES used for 433Mhz data packets
 // These are variables but some are basic such as 1: power is ON, 0: power is off
+// PRIORITIES of the 433Mhz data packets waiting to be sent
+#define RF433_PRIORITY_NORMAL         1
+#define RF433_PRIORITY_HIGH           2   // Pump power status
 
 
 // LCD Screen Display settings
@@ -97,6 +102,7 @@ String  DEVICE_NAME = "BKO-DMZ-CTL1";
 #define SSD_L7 57
 #define PIXELS_PER_CHAR 7
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+OledScreen oled(display, Wire, SCREEN_ADDRESS);   // Partial refreshes, see displayDeviceStatus()
 
 // WIFI settings
 #define DEV_WIFI_MODE_AP   // DEV_WIFI_MODE_AP or DEV_WIFI_MODE_STATION
@@ -117,6 +123,7 @@ IPAddress IP;
 #define DISPLAY_MODE_WIFI               1
 #define DISPLAY_MODE_FREQUENCY_SETUP    2
 #define DISPLAY_MODE_REBOOT             3
+#define DISPLAY_SCREEN_SPLASH           100   // Not a mode, only shown at boot
 int DISPLAY_MODE = 0;
 
 // WATER MEASURES settings
@@ -132,26 +139,14 @@ float publicKlong_RawDataWaterDistance = 0.0; // In centimeters, the distance be
 float publicKlong_SensorWaterDistance = 0.0;  // In centimeters, the distance between the sensor and the water after applying smart dataset noise reduction logic
 float publicKlong_CurrentWaterLevel = 0.0;    // In centimeters, the current relative water level from the virtual zero level. 
                                               // n > 0 = water is above target, n < 0 = water is below target
-int   publicKlong_PumpMinimumWaterLevel = 30; // Distance from Sensor to water level needed to start the pump safely
-int   publicKlong_PumpDecision = 0;
 String systemAnalysis = "";
-// Provide options for how often we check water and make decisions
-// This helps for debug (more frequently in matter of seconds) or for production (every N minutes)
-int   waterSensorsReadFrequencyOptions[] = { 1, 5, 10, 15, 30, 60, 2 * 60, 5 * 60, 10 * 60, 15 * 60, 30 * 60, 45 * 60, 60 * 60, 120 * 60 };  // Intervals in seconds
-int   waterSensorsReadFrequencySelected = 5;  // The INDEX of the option selected (default index 5: 1 minute)
+// How often we check water and make decisions: see frequencyOptions (frequency_options.h)
+int   waterSensorsReadFrequencySelected = FREQUENCY_OPTION_DEFAULT;  // The INDEX of the option selected
 int   waterSensorsReadFrequencySelection = waterSensorsReadFrequencySelected;  // The INDEX of the option selected
 unsigned long waterSensorsLastReadTickerMS = 0;
 unsigned long waterSensorsPublicKlongLastDataReceivedMS = 0;
-bool  needRevaluationOfSituation = false;
-int publicKlong_overheat_protection_max_runtime_minutes = 6 * 60;  // Pump should not run for more than that, otherwise might overheat
-int publicKlong_overheat_protection_time_off_minutes = 15;         // How long should the pump be stay off for overheat protection
-bool publicKlong_overheat_protection_activated = false;            // Tracks if overheat protection is activated
-unsigned long publicKlong_overheat_protection_kickoff_ms = 0;      // Track time since the pump was forced off for overheat protection
 
-#define master_mode_automated "AUTO"
-#define master_mode_forced_off "FORCED OFF"
-#define master_mode_forced_on   "FORCED ON"
-String master_operations_mode = master_mode_automated;
+MasterMode masterMode = MasterMode::Auto;  // Names only at the edges: masterModeName()
 
 
 #define MASTER_MODE_PUBLIC_PUMP_MANUAL_OFF
@@ -168,24 +163,66 @@ long duration;
 float distanceCm;
 
 // RELAY / PUMP Control settings
+// One line per pump in pumpConfigs: relay, sensor it follows, thresholds and overheat
+// protection (see include/pump_controller.h). Up to MAX_PUMPS pumps.
+#define MAX_PUMPS                   8
+#define PUMP_PUBLIC_KLONG           0     // Index in pumpConfigs
+#define PUMP_SOUTH_KLONG            1
 #define PUBLIC_KLONG_RELAY_PIN      14
 #define PUBLIC_KLONG_RELAY_LED_PIN  12
-bool  publicKlong_powered = 0;
-float publicKlong_operating_time_min = 0.0; // Total minutes since the pump started
-unsigned long publicKlong_operating_time_sec = 0; // Total Seconds since the pump started
-unsigned long publicKlong_operating_start = 0;    // Current milliseconds when the pump started
-
-#define SOUTH_KLONG_RELAY_PIN  27
-#define SOUTH_KLONG_RELAY_LED_PIN  0
-bool  southKlong_powered = 0;
-float southKlong_operating_time_min = 0.0;  // Total minutes since the pump started
-unsigned long southKlong_operating_time_sec = 0;  // Total Seconds since the pump started
-unsigned long southKlong_operating_start = 0;     // Current milliseconds when the pump started
+#define SOUTH_KLONG_RELAY_PIN       27
+#define SOUTH_KLONG_RELAY_LED_PIN   0
+const PumpConfig pumpConfigs[] = {
+  // Valid measures (cm), minimum water level (cm, distance from sensor to water needed to start the pump
+  // safely), overheat protection: max runtime (min) then how long the pump stays off (min)
+  { "Public Klong", PUBLIC_KLONG_RELAY_PIN, PUBLIC_KLONG_RELAY_LED_PIN, &publicKlong_SensorWaterDistance, { 5, 300, 30, 6 * 60, 15 }, true },
+  { "South Klong", SOUTH_KLONG_RELAY_PIN, SOUTH_KLONG_RELAY_LED_PIN, &southKlong_SensorWaterDistance, { 5, 300, 30, 6 * 60, 15 }, false },  // NOT IMPLEMENTED (no sensor yet)
+};
+PumpController<MAX_PUMPS> pumps;
 
 // Constants for Remotes On/Off commands (RM1: Remote 1, RM2: Remote 2)
 #define RM2_A_ON  4195665
 #define RM2_A_OFF 4195668
 
+// 433Mhz REMOTES (see include/rf_commands.h)
+// Built-in: the Phenix remotes, hashed at compile time. Remote 2 button A forces the pumps on / off.
+// Learned: any other code bound to an action from the web (/learn), kept in NVS.
+constexpr RfCommand rfRemotes[] = {
+  // Phenix RM 2  (DIP: 01111)
+  { RM2_A_ON,  "PH2-A-ON",  RfAction::PumpsOn },
+  { RM2_A_OFF, "PH2-A-OFF", RfAction::PumpsOff },
+  { 4198737,   "PH2-B-ON",  RfAction::None },
+  { 4198740,   "PH2-B-OFF", RfAction::None },
+  { 4199505,   "PH2-C-ON",  RfAction::None },
+  { 4199508,   "PH2-C-OFF", RfAction::None },
+  { 4199697,   "PH2-D-ON",  RfAction::None },
+  { 4199700,   "PH2-D-OFF", RfAction::None },
+  // Phenix RM 1  (DIP: 00000)
+  { 5588305,   "PH1-A-ON",  RfAction::None },
+  { 5588308,   "PH1-A-OFF", RfAction::None },
+  { 5591377,   "PH1-B-ON",  RfAction::None },
+  { 5591380,   "PH1-B-OFF", RfAction::None },
+  { 5592145,   "PH1-C-ON",  RfAction::None },
+  { 5592148,   "PH1-C-OFF", RfAction::None },
+  { 5592337,   "PH1-D-ON",  RfAction::None },
+  { 5592340,   "PH1-D-OFF", RfAction::None },
+};
+constexpr RfCommandTable rfRemoteTable(rfRemotes);
+static_assert(rfRemoteTable.valid(), "rfRemotes: no perfect hash found (same code twice?)");
+#define prefRfLearned              "rfLearned"
+#define RF433_LEARNED_MAX          256
+#define RF433_LEARN_TIMEOUT_MS     (30 * 1000UL)  // /learn waits that long for a code
+#define RF433_COMMAND_DEBOUNCE_MS  1000           // A button press sends its code several times
+#define RF433_TELEMETRY_MIN_CODE   10000000UL     // deviceid * 10^7 + datatype * 10^6 + value: our own frames
+#define RF433_OWN_ECHO_MS          500            // A code we just sent, heard back by our own receiver
+#define RF433_LEARN_OFF            -1             // rfLearnRequest values besides an RfAction
+#define RF433_LEARN_FORGET         -2
+#define RF433_LEARN_CLEAR          -3
+LearnedRemotes<RF433_LEARNED_MAX> rfLearned;
+volatile int rfLearnRequest = RF433_LEARN_OFF;   // Set by the web server, handled by loop()
+volatile unsigned long rfLearnRequestMS = 0;
+void handleRF433Code(uint32_t code);
+
 #define LIGHT_ON true
 #define LIGHT_OFF false
 
@@ -194,14 +231,36 @@ int GPIO_TRANSMIT_PIN = 25;
 int mode = 1;   // (1: Learn,  2: Display)
 int lastRFvalue = 0;
 int previousRFvalue = -1;
-unsigned long previousMS = 0;
-unsigned long previousStatsMS = 0;
 bool displayUpdateMark = false;
 String lastCommand = "?";
 bool virtualPlug2A = false;
 int onboardLEDStatus = 0;
 
 RCSwitch myRadioSignalSwitch = RCSwitch();
+// 433Mhz transmissions are queued and sent by a background service (see include/rf_tx_queue.h)
+#define RF433_TX_GAP_MS 200                 // Silence between two transmissions
+#define RF433_TX_CORE 1                     // loop()'s core, away from the WiFi / lwIP tasks (core 0)
+#define RF433_TX_PRIORITY 2                 // Above loop() (1) and the other services
+RfTxQueue<8> rf433TxQueue;
+unsigned long rf433TxNextAllowedMS = 0;
+volatile bool rf433TxSending = false;     // A code is on air (the chip must not light sleep)
+volatile uint32_t rf433LastSentCode = 0;
+volatile unsigned long rf433LastSentMS = 0;
+
+// 433Mhz TELEMETRY (statistics)
+// Values are only sent when they change more than a deadband, plus a slow keepalive
+// so the receiver knows we are still alive (see sendRF433MhzTelemetry)
+typedef struct TelemetryChannel {
+  int deadband;                   // In the unit of the value sent (e.g. cm x 100 for water levels)
+  int lastValueSent;
+  unsigned long lastSentMS;
+  bool sentOnce;
+} TelemetryChannel;
+unsigned long telemetryHeartbeatMS = 5 * 60 * 1000UL;                     // Keepalive: resend unchanged values every 5 minutes
+TelemetryChannel telemetryPublicKlongWaterLevel = { 100, 0, 0, false };  // Deadband: 1cm
+TelemetryChannel telemetryPublicKlongPower = { 0, 0, 0, false };         // Any change
+uint32_t telemetryFramesSent = 0;
+uint32_t telemetryFramesSuppressed = 0;
 
 // Forward Declarations
 void displayStatus(void);
@@ -209,16 +268,45 @@ void displayDeviceStatus(void);
 void updateWifiStatus(void);
 void updateDisplay(void);
 void displaySplashScreen(void);
-void sendRF433MhzPowerInfo(int);
-void sendRF433MhzCode(int, int, int);
+bool flushOledDisplay(void);
+void sendRF433MhzPowerInfo(const Pump &pump);
+void sendRF433MhzCode(int, int, int, uint8_t priority = RF433_PRIORITY_NORMAL);
+bool transmitNextRF433MhzCode(void);
 
 // Dynamic Preferences for all appropriate settings
+// All the settings are saved together in one blob (see include/settings_store.h),
+// written once changes have settled: handlers only update the RAM copy.
+#define prefSettings                     "settings"
+#define SETTINGS_LAYOUT_VERSION          1      // Change it whenever PersistentSettings changes
+#define SETTINGS_DEBOUNCE_MS             2000   // Written 2s after the last change
+// Before the settings blob, one key per setting (only read once, to migrate)
 #define prefNameWaterSensorReadFrequency "waterSensReadFq"
 #define prefRequiredDistancePublicKlong  "waterSensMinLvl"
 #define prefMasterOperationsMode         "masterOpsMode"
 #define prefRequiredDistancePublicKlong_default  30
 Preferences preferences;
 
+typedef struct PersistentSettings {
+  uint8_t frequencyOption;              // Index in frequencyOptions
+  uint8_t masterMode;                   // MasterMode (see include/pump_state_machine.h)
+  uint8_t lowPowerMode;
+  uint8_t reserved;
+  int32_t pumpMinimumWaterLevel;
+} PersistentSettings;
+SettingsStore<PersistentSettings> settingsStore(preferences, prefSettings, SETTINGS_DEBOUNCE_MS, SETTINGS_LAYOUT_VERSION);
+void saveSettings(void);
+void saveBeforeReboot(void);
+
+// HISTORY: months of water levels and pump runtimes on SPIFFS (see include/history_store.h),
+// written by a background service
+HistoryStore history;
+static_assert(MAX_PUMPS <= HISTORY_MAX_PUMPS, "History records have a duty per pump");
+#define HISTORY_DEFAULT_POINTS 500      // /history chart points
+#define HISTORY_MAX_POINTS     2000
+bool flushHistory() {
+  return history.flush();
+}
+
 using namespace ace_button;
 // Initialize all smart buttons
 #define BUTTON_MENU_PIN         26
@@ -231,158 +319,129 @@ AceButton btnIncOptions(BUTTON_INC_OPTIONS_PIN);
 AceButton btnConfirm(BUTTON_CONFIRM_PIN);
 void btnHandleEvent(AceButton*, uint8_t, uint8_t);
 
+// SCHEDULER
+// loop() only runs the scheduler: each job is a task that runs on its period
+// and/or when its event wakes it up, the core idles in between (see include/cooperative_scheduler.h)
+CooperativeScheduler<8> scheduler;
+int taskButtons, taskPackets, taskRadio433, taskTick, taskStats, taskAnalysis, taskSettings;
+#define BUTTONS_POLL_MS      5      // AceButton needs frequent check() calls while a button is used...
+#define BUTTONS_ACTIVE_MS 2000      // ...long enough after the last edge for double clicks / long presses
+#define RADIO433_POLL_MS   100
+#define TICK_MS           1000
+#define STATS_MS          5000
+volatile unsigned long buttonsLastEdgeMS = 0;
+const uint8_t buttonPins[] = { BUTTON_MENU_PIN, BUTTON_DEC_OPTIONS_PIN, BUTTON_INC_OPTIONS_PIN, BUTTON_CONFIRM_PIN };
+
+// LOW POWER MODE
+// With long analysis intervals nothing happens for minutes. When enabled (web /powermode)
+// and nobody is around (no web client, buttons untouched, pumps off): the OLED is switched
+// off, telemetry goes out in one batch after each analysis, and the chip light sleeps.
+// It wakes up when a button is pressed, or LOW_POWER_LISTEN_MS before each analysis
+// to receive fresh sensor data (the radio is off while asleep, ESP-NOW packets are missed).
+#define LOW_POWER_MIN_FREQUENCY_SECONDS  (15 * 60)          // Not worth it with shorter intervals
+#define LOW_POWER_AFTER_INPUT_MS         (2 * 60 * 1000UL)  // Stay awake that long after a button was used
+#define LOW_POWER_LISTEN_MS              (30 * 1000UL)      // Awake before each analysis
+#define LOW_POWER_TICK_MS                (60 * 1000UL)      // Housekeeping tick while in low power
+#define LOW_POWER_MIN_SLEEP_MS           100                // Shorter idle times are not worth a light sleep
+bool lowPowerModeEnabled = false;     // Setting
+bool lowPowerActive = false;          // Currently in low power
+void updatePowerMode(void);
+void powerAwareIdle(uint32_t maxMs);
+void onButtonEdge(void);
+void runButtonsTask(void);
+void runRadio433Task(void);
+void runTickTask(void);
+void runAnalysisTask(void);
+void runSettingsTask(void);
+void requestRevaluation(void);
+void scheduleNextAnalysis(void);
+
 // Initialize Async Web Server used by OTA (and maybe other stuff)
 AsyncWebServer server(80);
 AsyncWebSocket ws("/ws");
 
+// METRICS (GET /metrics, Prometheus text, see include/metrics.h)
+// Build with -DMETRICS_ENABLED=0 to compile them out
+MetricHistogram metricLoopBusy("dmz_loop_busy_seconds", "loop() pass running tasks (idle time excluded)");
+MetricHistogram metricAnalysis("dmz_analyze_water_levels_seconds", "analyzeWaterLevels()");
+MetricHistogram metricNotifyClients("dmz_notify_clients_seconds", "notifyClients() websocket status");
+MetricHistogram metricUpdateDisplay("dmz_update_display_seconds", "updateDisplay()");
+MetricHistogram metricRf433Queue("dmz_rf433_send_seconds", "433Mhz code queued (sendRF433MhzCode) and transmitted", "stage=\"queue\"");
+MetricHistogram metricRf433Transmit("dmz_rf433_send_seconds", "433Mhz code queued (sendRF433MhzCode) and transmitted", "stage=\"transmit\"");
+MetricCounter metricEspNowReceived("dmz_espnow_packets_received_total", "ESP-NOW sensor packets received");
+MetricCounter metricEspNowBadSize("dmz_espnow_packets_rejected_total", "ESP-NOW sensor packets not used", "reason=\"size\"");
+MetricCounter metricEspNowQueueFull("dmz_espnow_packets_rejected_total", "ESP-NOW sensor packets not used", "reason=\"queue_full\"");
+MetricCounter metricEspNowOutOfBand("dmz_espnow_packets_rejected_total", "ESP-NOW sensor packets not used", "reason=\"out_of_band\"");
+MetricGauge metricHeapFree("dmz_heap_free_bytes", "Free heap");
+MetricGauge metricHeapMinFree("dmz_heap_min_free_bytes", "Lowest free heap since boot");
+MetricGauge metricStackLoop("dmz_task_stack_free_bytes", "Stack never used so far (low-water mark)", "task=\"loop\"");
+MetricGauge metricStackRf433("dmz_task_stack_free_bytes", "Stack never used so far (low-water mark)", "task=\"rf433tx\"");
+MetricGauge metricStackOled("dmz_task_stack_free_bytes", "Stack never used so far (low-water mark)", "task=\"oled\"");
+MetricGauge metricStackHistory("dmz_task_stack_free_bytes", "Stack never used so far (low-water mark)", "task=\"history\"");
+MetricGauge metricStackTrace("dmz_task_stack_free_bytes", "Stack never used so far (low-water mark)", "task=\"trace\"");
+MetricGauge metricWsClients("dmz_websocket_clients", "Connected websocket clients");
+MetricGauge metricUptime("dmz_uptime_seconds", "Time since boot");
+MetricTimer loopBusyTimer(metricLoopBusy, false);
+
+// TRACE LOG (see include/trace_log.h)
+// Hot paths trace into a RAM ring instead of printing: the "trace" background service
+// formats and prints the records on core 0 at the lowest priority, so a Serial line
+// never blocks loop() or the 433Mhz transmissions anymore.
+// Build with -DTRACE_LEVEL=TRACE_LEVEL_DEBUG for the 433Mhz raw pulses and button events
+enum TraceEvent : uint16_t {
+  TRACE_SENSOR_PACKET,
+  TRACE_ANALYSIS_START,
+  TRACE_PUMP_DECISION,
+  TRACE_MASTER_MODE,
+  TRACE_RF433_SEND,
+  TRACE_RF433_OUT_OF_RANGE,
+  TRACE_RF433_QUEUE_FULL,
+  TRACE_RF433_RECEIVED,
+  TRACE_RF433_RAW,
+  TRACE_POWER_MODE,
+  TRACE_SETTINGS_SAVED,
+  TRACE_BUTTON_EVENT,
+  TRACE_BUTTON_CLICK,
+  TRACE_FREQUENCY_SELECTION,
+  TRACE_WS_CLIENT,
+  TRACE_WS_JSON_OVERFLOW,
+  TRACE_RF433_COMMAND,
+  TRACE_RF433_LEARN,
+};
+void formatRF433Received(const TraceRecord &record, char *out, size_t size);
+const TraceEventInfo traceEvents[] = {
+  { "From sensor: %.2fcm, Timer: %u Elapse: %u sec" },
+  { "Time for analysis! Frequency: %s" },
+  { "DEBUG ANALYSIS: %s %s %s -> %s" },
+  { "Master Operations Mode set to %s" },
+  { "Sending 433Mhz code: %u" },
+  { "433Mhz: Out of range value! DeviceID: %d DataType: %d Value: %d" },
+  { "433Mhz: Queue full, code dropped: %u" },
+  { nullptr, formatRF433Received },
+  { "Raw data [%u]: %u,%u,%u" },
+  { "Power: %s" },
+  { "Settings: saved (NVS lifetime writes %u)" },
+  { "%s: event %u" },
+  { "%s: CLICK" },
+  { "Frequency option %u -> %u" },
+  { "WebSocket client #%u %s" },
+  { "WebSocket: status JSON buffer too small!" },
+  { "433Mhz command: %u %s (action: %s)" },
+  { "433Mhz learn: %u %s" },
+};
+static_assert(sizeof(traceEvents) / sizeof(traceEvents[0]) == TRACE_RF433_LEARN + 1, "traceEvents: one entry per TraceEvent");
+TraceLog<64> traceLog;
+MetricCounter metricTraceDropped("dmz_trace_records_dropped_total", "Trace records dropped (ring full)");
+bool drainTraceLog();
 
-// MEASUREMENTS DATASET CLEANUP
-// Smooths data to eliminate noise
-const int maxMeasures = 30;
-const int maxHighestMeasures = 20;
-float measures[maxMeasures];
-int measureIndex = -1;
-// int highestMeasureIndex = -1;
-int measureCollectionRound = 1;
-// Simply return the average of all measurements
-float getMeasurementsAvg() {
-  float total = 0.0;
-  for (int i=0; i < maxMeasures; i++) {
-    total += measures[i];
-  }
-  float avg = total / 30.0;
-  return avg;
-}
-// Look at one full dataset and collect the N lowest points
-// then calculate the averate and replace all other poinst (higher points)
-// with the average.
-float applyHighestMeasuresAsAverage() {
-  float workMeasures[maxMeasures];            // We are aletering data so need to work on a copy
-  float originalMeasures[maxMeasures];        // This array will contain the original datapoints for DEBUG ONLY!
-  float lastHighestLevel = 0.0;
-  int lastHighestIndex = -1;
-  int highestMeasuresCount = 0;
-  float highestMeasuresSum = 0.0;
-  float highestMeasuresAvg = 0.0;
-  // Step 1: Copy the raw data before we alter it
-  //         to both work array and debug log array
-  for (int i=0; i < maxMeasures; i++) {
-    workMeasures[i] = measures[i];
-    originalMeasures[i] = measures[i];
-  }
-  // Step 2: - Find the next highest value for as many 
-  //           times needed to find out the maxHighestMeasues needed
-  //         - Calculate the average of those highest measures on the fly
-  DEBUG_LOG.println("Finding the top N highest measures...");
-  for (int m=0; m < maxHighestMeasures; m++) { 
-    DEBUG_LOG.print("Measures Scan #");
-    DEBUG_LOG.println(m + 1);
-    lastHighestLevel = 0.0;
-    // Find the highest value and its index
-    for (int i=0; i < maxMeasures; i++) { 
-      DEBUG_LOG.print("   ");
-      DEBUG_LOG.print(i);
-      DEBUG_LOG.print(" --> ");
-      DEBUG_LOG.print(workMeasures[i]);
-      if (workMeasures[i] > lastHighestLevel) {
-        lastHighestLevel = workMeasures[i];
-        lastHighestIndex = i;
-        DEBUG_LOG.print(" ! (last highest :");
-        DEBUG_LOG.print(lastHighestLevel);
-        DEBUG_LOG.print(" @");
-        DEBUG_LOG.print(lastHighestIndex);
-      }
-      DEBUG_LOG.println();
-    }
-    DEBUG_LOG.print("Last Highest Measure: ");
-    DEBUG_LOG.print(lastHighestLevel);
-    DEBUG_LOG.print(" at index ");
-    DEBUG_LOG.println(lastHighestIndex);
-    // Track the max values average
-    // Reset to -1 the highest value identified
-    highestMeasuresSum += workMeasures[lastHighestIndex];
-    highestMeasuresCount += 1;
-    workMeasures[lastHighestIndex] = -1;
-  }
-  // Calculate average of selected highest values
-  highestMeasuresAvg = highestMeasuresSum / (highestMeasuresCount * 1.0);
-  // Now we have identified the N highest measures
-  // We can replace all out-of-scope measures with the average
-  for (int i=0; i < maxMeasures; i++) {
-    if (workMeasures[i] != -1) {
-      measures[i] = highestMeasuresAvg; 
-    }
-  }
 
-  // Debug Serial output of data processing
-  DEBUG_LOG.print("Highest Average: ");
-  DEBUG_LOG.println(highestMeasuresAvg);
-  DEBUG_LOG.println();
-  DEBUG_LOG.println("Original  Highest  Outcome");
-  for (int i=0; i < maxMeasures; i++) {
-    DEBUG_LOG.print(originalMeasures[i]);
-    DEBUG_LOG.print("   ");
-    DEBUG_LOG.print(workMeasures[i]);
-    DEBUG_LOG.print("   ");
-    DEBUG_LOG.print(measures[i]);
-    DEBUG_LOG.println("   ");
-  }
-  return highestMeasuresAvg;
-}
-// Process raw data by adding processing received measures
-float addMeasureToMeasurements(float lastMeasure) {
-  float applicableMeasure = 0.0;
-  DEBUG_LOG.print("Round: ");
-  DEBUG_LOG.print(measureCollectionRound);
-  DEBUG_LOG.print("  Last index: ");
-  DEBUG_LOG.println(measureIndex);
-
-  // Process the first data collection as raw data
-  if (measureCollectionRound == 1) {
-    if (measureIndex < maxMeasures -1) {       // We are still filling up the first dataset
-      measureIndex += 1;              
-      measures[measureIndex] = lastMeasure;    // Add latest measure to it
-      applicableMeasure = 666;
-    } else {    // We have a full first dataset
-      measureIndex = 0;  // Prepare index for the next round
-      measureCollectionRound += 1;
-      applicableMeasure = applyHighestMeasuresAsAverage();
-      measures[measureIndex] = applicableMeasure;    // Add latest measure to it
-    }
-  } else {
-    if (measureIndex < maxMeasures -1) {
-      measureIndex += 1;              
-    } else {    // We have a full first dataset
-      measureIndex = 0;  // Prepare index for the next round
-      measureCollectionRound += 1;
-    }
-    // At this point we have our baseline, we can decide
-    // what to do with new value if within x% of the average of highest measures:
-    // - Accept the last measurement, add to measurements and return it as latest value
-    // - Reject the last measurement, add the average into measurements instead and return the average value
-    float measurementsAvg = getMeasurementsAvg();
-    if (   (lastMeasure - measurementsAvg) / measurementsAvg < -0.03 
-        || (lastMeasure - measurementsAvg) / measurementsAvg > 0.03 ) {
-      applicableMeasure = measurementsAvg;
-      measures[measureIndex] = applicableMeasure;
-      DEBUG_LOG.print("New Measure: OUT OF BOUND. Measure: ");
-      DEBUG_LOG.print(lastMeasure);
-      DEBUG_LOG.print("  Applicable: ");
-      DEBUG_LOG.print(applicableMeasure);
-      DEBUG_LOG.print("  Average: ");
-      DEBUG_LOG.println(measurementsAvg);
-    } else {
-      // applicableMeasure = lastMeasure;
-      measures[measureIndex] = lastMeasure;
-      applicableMeasure = measurementsAvg;
-      DEBUG_LOG.print("New Measure: ACCEPTED. Measure: ");
-      DEBUG_LOG.print(lastMeasure);
-      DEBUG_LOG.print("  Average: ");
-      DEBUG_LOG.println(measurementsAvg);
-    }
-  }
-  return applicableMeasure;
-}
+// MEASUREMENTS DATASET CLEANUP
+// Smooths data to eliminate noise. Each sensor has its own filter chain,
+// see include/sensor_filters.h for the available stages.
+// Public Klong: keep the 20 highest of the first 30 measures as baseline,
+// then only accept new measures within +/-3% of the average
+typedef FilterChain<TopKBandFilter<30, 20, 30>> PublicKlongSensorFilter;
+PublicKlongSensorFilter publicKlong_SensorFilter;
 
 // ESP-NOW Klong Sensor Data Structure
 typedef struct klong_sensor_data_message {
@@ -392,109 +451,97 @@ typedef struct klong_sensor_data_message {
   unsigned long millis;
   float waterDistance;
 } klong_sensor_data_message;
-klong_sensor_data_message klongData;
 unsigned long publicKlong_last_received_message_ms = 0;
 unsigned long publicKlong_time_since_last_message_ms = 0;
 
+// Packets are received in the WiFi task and processed in loop(),
+// they are passed through a lock-free queue (see include/spsc_queue.h)
+typedef struct klong_sensor_packet {
+  klong_sensor_data_message message;
+  unsigned long receivedMS;             // millis() when the packet was received
+} klong_sensor_packet;
+SpscQueue<klong_sensor_packet, 16> klongPacketQueue;
+
 // Callback function that will be executed when data is received from Sensors via ESP-NOW
+// Runs in the WiFi task: keep it short, just validate and queue the packet for loop()
 void onKlongDataReciever(const uint8_t * mac, const uint8_t *incomingData, int len) {
-  // Serial.print(len);
-  // Serial.print(" Bytes received from ");
-  //  for (int i = 0; i < 6; i++) {
-  //    Serial.print("0x");
-  //    Serial.print(mac[i], HEX);
-  //    Serial.print(":");
-  //  }
-  // Serial.println();
-  memcpy(&klongData, incomingData, sizeof(klongData));
-  publicKlong_time_since_last_message_ms = klongData.millis - publicKlong_last_received_message_ms;
-  publicKlong_last_received_message_ms = klongData.millis;
-  publicKlong_RawDataWaterDistance = klongData.waterDistance;
-  publicKlong_SensorWaterDistance = addMeasureToMeasurements(klongData.waterDistance);   // TODO: Plug data cleanup call here
-  Serial.print("From ");
-  Serial.print(klongData.deviceId);
-  Serial.print(" (");
-  Serial.print(klongData.version);
-  Serial.print("): ");
-  Serial.print(klongData.waterDistance);
-  Serial.print("cm, Timer: ");
-  Serial.print(klongData.millis);
-  Serial.print(" Elapse: ");
-  Serial.print(publicKlong_time_since_last_message_ms / 1000);
-  Serial.println(" sec");
-  waterSensorsPublicKlongLastDataReceivedMS = millis();
+  metricEspNowReceived.inc();
+  if (len != sizeof(klong_sensor_data_message)) {
+    metricEspNowBadSize.inc();
+    return;
+  }
+  klong_sensor_packet packet;
+  memcpy(&packet.message, incomingData, sizeof(packet.message));
+  packet.receivedMS = millis();
+  klongPacketQueue.push(packet);        // If loop() is late and the queue is full, the packet is dropped (and counted)
+  scheduler.wake(taskPackets);
+}
+
+uint32_t getKlongPacketsDropped() {
+  return klongPacketQueue.dropped();
+}
+
+#if METRICS_ENABLED
+// Gauges and copied counters, sampled right before a /metrics export (web server task)
+void collectMetrics() {
+  metricEspNowQueueFull.set(klongPacketQueue.dropped());
+  metricHeapFree.set(ESP.getFreeHeap());
+  metricHeapMinFree.set(ESP.getMinFreeHeap());
+  metricStackLoop.set(loopStackFree());
+  metricStackRf433.set(backgroundServiceStackFree(transmitNextRF433MhzCode));
+  metricStackOled.set(backgroundServiceStackFree(flushOledDisplay));
+  metricStackHistory.set(backgroundServiceStackFree(flushHistory));
+  metricStackTrace.set(backgroundServiceStackFree(drainTraceLog));
+  metricWsClients.set(ws.count());
+  metricUptime.set(millis() / 1000);
+}
+#endif
+
+// Consume the packets received from the Sensors (called from loop())
+void processKlongDataPackets() {
+  klong_sensor_packet packet;
+  while (klongPacketQueue.pop(packet)) {
+    klong_sensor_data_message &klongData = packet.message;
+    publicKlong_time_since_last_message_ms = klongData.millis - publicKlong_last_received_message_ms;
+    publicKlong_last_received_message_ms = klongData.millis;
+    publicKlong_RawDataWaterDistance = klongData.waterDistance;
+    if (!publicKlong_SensorFilter.process(klongData.waterDistance, publicKlong_SensorWaterDistance)) {
+      publicKlong_SensorWaterDistance = 0.0;   // Filter still settling: no valid measure yet
+    }
+    metricEspNowOutOfBand.set(publicKlong_SensorFilter.rejected());
+    // Device id / version are not traced: only pointers to static strings can be
+    TRACE(TRACE_LEVEL_INFO, TRACE_SENSOR_PACKET, klongData.waterDistance, klongData.millis, publicKlong_time_since_last_message_ms / 1000);
+    waterSensorsPublicKlongLastDataReceivedMS = packet.receivedMS;
+  }
 }
 
 int getPreferredSensorRefreshFrequencyInSeconds() {
-  return waterSensorsReadFrequencyOptions[waterSensorsReadFrequencySelected];
+  return frequencyOptions[waterSensorsReadFrequencySelected].seconds;
 }
 
 int getPreferredSensorRefreshFrequencyInSeconds(int selectedIndex) {
-  return waterSensorsReadFrequencyOptions[selectedIndex];
+  return frequencyOptions[selectedIndex].seconds;
 }
 
-char strBuff[20];
-char * getPreferredSensorRefreshFrequencyAsString() {
-  int freq = getPreferredSensorRefreshFrequencyInSeconds();
-  if (freq < 60) {
-    snprintf(strBuff, sizeof(strBuff), "%i sec", freq);
-  } else {
-    snprintf(strBuff, sizeof(strBuff), "%i min", freq / 60);
-  }
-  return strBuff;
+const char * getPreferredSensorRefreshFrequencyAsString() {
+  return frequencyOptions[waterSensorsReadFrequencySelected].label;
 }
 
-char * getPreferredSensorRefreshFrequencyAsString(int selectedIndex) {
-  int freq = getPreferredSensorRefreshFrequencyInSeconds(selectedIndex);
-  if (freq < 60) {
-    snprintf(strBuff, sizeof(strBuff), "%i sec", freq);
-  } else {
-    snprintf(strBuff, sizeof(strBuff), "%i min", freq / 60);
-  }
-  return strBuff;
+const char * getPreferredSensorRefreshFrequencyAsString(int selectedIndex) {
+  return frequencyOptions[selectedIndex].label;
 }
 
 
 #pragma region Pump Controllers
 
-void startPump1() {
-  int previousState = publicKlong_powered;
-  publicKlong_powered = 1;
-  sendRF433MhzPowerInfo(publicKlong_powered);
-  digitalWrite(PUBLIC_KLONG_RELAY_PIN, LOW);
-  digitalWrite(PUBLIC_KLONG_RELAY_LED_PIN, !digitalRead(PUBLIC_KLONG_RELAY_PIN));
-  if (previousState == 1) return;  // Do nothing if it was already in required state
-  publicKlong_operating_start = millis();
-  publicKlong_operating_time_sec = 0;
-}
-
-void stopPump1() {
-  int previousState = publicKlong_powered;
-  publicKlong_powered = 0;
-  sendRF433MhzPowerInfo(publicKlong_powered);
-  digitalWrite(PUBLIC_KLONG_RELAY_PIN, HIGH);
-  digitalWrite(PUBLIC_KLONG_RELAY_LED_PIN, !digitalRead(PUBLIC_KLONG_RELAY_PIN));
-  if (previousState == 0) return;  // Do nothing if already required state
-  publicKlong_operating_start = 0;
-  publicKlong_operating_time_sec = 0;
-}
-
-void startPump2() {
-  if (southKlong_powered) return;  // Do nothing if already required state
-  southKlong_powered = 1;
-  southKlong_operating_start = millis();
-  southKlong_operating_time_sec = 0;
-  digitalWrite(SOUTH_KLONG_RELAY_PIN, LOW);
-  digitalWrite(SOUTH_KLONG_RELAY_LED_PIN, !digitalRead(SOUTH_KLONG_RELAY_PIN));
-}
-
-void stopPump2() {
-  if (!southKlong_powered) return;  // Do nothing if already required state
-  southKlong_powered = 0;
-  southKlong_operating_start = 0;
-  southKlong_operating_time_sec = 0;
-  digitalWrite(SOUTH_KLONG_RELAY_PIN, HIGH);
-  digitalWrite(SOUTH_KLONG_RELAY_LED_PIN, !digitalRead(SOUTH_KLONG_RELAY_PIN));
+// Every start / stop request: 433Mhz power info (only the Public Klong pump has a device id)
+void onPumpPower(int id, const Pump &pump) {
+  if (id == PUMP_PUBLIC_KLONG) sendRF433MhzPowerInfo(pump);
+}
+
+void setupPumps() {
+  for (const PumpConfig &config : pumpConfigs) pumps.add(config);   // Relays off right away
+  pumps.setPowerHook(onPumpPower);
 }
 
 #pragma endregion
@@ -504,17 +551,33 @@ void calculateWaterLevels() {
   southKlong_CurrentWaterLevel = southKlongSensor_VirtualZero - southKlong_SensorWaterDistance;
 }
 
+// Send a statistics value over 433Mhz only if it moved more than the channel
+// deadband since the last one sent, or if the keepalive (heartbeat) is due
+void sendRF433MhzTelemetry(TelemetryChannel &channel, int deviceid, int datatype, int value, uint8_t priority) {
+  bool changed = !channel.sentOnce || abs(value - channel.lastValueSent) > channel.deadband;
+  bool heartbeat = (millis() - channel.lastSentMS) >= telemetryHeartbeatMS;
+  if (!changed && !heartbeat) {
+    telemetryFramesSuppressed++;
+    return;
+  }
+  channel.sentOnce = true;
+  channel.lastValueSent = value;
+  channel.lastSentMS = millis();
+  telemetryFramesSent++;
+  sendRF433MhzCode(deviceid, datatype, value, priority);
+}
+
 void sendWaterLevelStatistics() {
   // Send Water data over 433Mhz for statistics
   if (publicKlong_SensorWaterDistance > 999) {
-    sendRF433MhzCode(DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_WLVL, 999 * 100);
+    sendRF433MhzTelemetry(telemetryPublicKlongWaterLevel, DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_WLVL, 999 * 100, RF433_PRIORITY_NORMAL);
   } else {
-    sendRF433MhzCode(DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_WLVL, publicKlong_SensorWaterDistance * 100);
+    sendRF433MhzTelemetry(telemetryPublicKlongWaterLevel, DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_WLVL, publicKlong_SensorWaterDistance * 100, RF433_PRIORITY_NORMAL);
   }
 }
 
 void sendPumpPowerStatistics() {
-  sendRF433MhzPowerInfo(publicKlong_powered);
+  sendRF433MhzPowerInfo(pumps[PUMP_PUBLIC_KLONG]);
 }
 
 void sendStatistics() {
@@ -522,101 +585,24 @@ void sendStatistics() {
   sendPumpPowerStatistics();
 }
 
-void updatePumpTimers() {
-  // If either timers data show a CPU roll-over, reset timers
-  if (millis() < publicKlong_operating_start || millis() < southKlong_operating_start) {
-    publicKlong_operating_start = 0;
-    publicKlong_operating_time_sec = 0;
-    publicKlong_operating_time_min = 0.0;
-    return;
-  } 
-
-  // Public Klong
-  unsigned long publicKlong_ElapseMS = millis() - publicKlong_operating_start;
-  publicKlong_operating_time_sec = publicKlong_ElapseMS / 1000;
-  publicKlong_operating_time_min = (publicKlong_operating_time_sec / 60) + ((publicKlong_operating_time_sec % 60) / 100.0);
-  
-  // South Klong
-  unsigned long southKlong_ElapseMS = millis() - southKlong_operating_start;
-  southKlong_operating_time_sec = southKlong_ElapseMS / 1000;
-  southKlong_operating_time_min = (southKlong_operating_time_sec / 60) + ((southKlong_operating_time_sec % 60) / 100.0);
-}
-
+// Check water levels to make decisions (see include/pump_decision.h), for every pump:
+// - If South Klong is full, no need to pump
+// - If South Klong needs wather, check if there is enough water in Public Klong to operate the pump
+// Override any decision if operations mode has been set to ON or OFF
 void analyzeWaterLevels() {
+  MetricTimer timer(metricAnalysis);
   // Analyze Water Levels to conclude what to do
   systemAnalysis = "Checking...";
 
-  updatePumpTimers();
-
-  Serial.print("DEBUG ANALYSIS STARTED: ");
-
-  // Check water levels to make decisions:
-  // - If South Klong is full, no need to pump
-  // - If South Klong needs wather, check if there is enough water in Public Klong to operate the pump
-  // Override any decision if operations mode has been set to ON or OFF
-  if (master_operations_mode ==  master_mode_forced_on) {
-    // If Mode is FORCED ON then just turn the pump ON
-    publicKlong_PumpDecision = 1;
-    publicKlong_overheat_protection_activated = false;
-    Serial.print("A");
-  } else if (master_operations_mode ==  master_mode_forced_off) {
-    // If Mode is FORCED OFF then just turn the pump OFF
-    publicKlong_PumpDecision = 0;
-    publicKlong_overheat_protection_activated = false;
-    Serial.print("B");
-  } else if ( publicKlong_SensorWaterDistance > 300 || publicKlong_SensorWaterDistance < 5) {
-    // Cannot make decisions if the sensors returns unrealistic numbers
-    // For protection, turn the pump OFF because we just don't know if there is water 
-    systemAnalysis = "Invalid measure!";
-    publicKlong_PumpDecision = 0;
-    Serial.print("C");
-  } else if (publicKlong_PumpMinimumWaterLevel > publicKlong_SensorWaterDistance) {
-    // We have enough water to activate the PUMP, but there are more conditions...
-    Serial.print("D");
-    if ( (publicKlong_operating_time_min > publicKlong_overheat_protection_max_runtime_minutes) && !publicKlong_overheat_protection_activated) {
-      // The Pump has been running for more than acceptable time
-      // so we enable the overheat protection
-      publicKlong_operating_time_min = 0;
-      publicKlong_overheat_protection_kickoff_ms = millis();
-      publicKlong_overheat_protection_activated = true;
-      publicKlong_PumpDecision = 0;
-      systemAnalysis = "Overheat protection activated";
-      Serial.print("E");
-    } else {
-      // We have enough water, just need to check if we are in overheat protection or not
-      Serial.print("F");
-      if (publicKlong_overheat_protection_activated) {
-        Serial.print("G");
-        // As we are under overheat protection, check if it has been off long enough
-        if (((millis() - publicKlong_overheat_protection_kickoff_ms) / 1000 / 60) >= publicKlong_overheat_protection_time_off_minutes) {
-          // It's been OFF long enough for overheat protection, we can restart the pump
-          publicKlong_overheat_protection_activated = false;
-          publicKlong_PumpDecision = 1;
-          systemAnalysis = "Overheat protection ended";
-          Serial.print("H");
-        } else {
-          publicKlong_PumpDecision = 0;
-          systemAnalysis = "Overheat protection activated";
-          Serial.print("I");
-        }
-      } else {
-        publicKlong_PumpDecision = 1;
-        systemAnalysis = "OK to pump!";
-        Serial.print("J");
-      }
-    }
-  } else {
-    publicKlong_PumpDecision = 0;
-    systemAnalysis = "Water TOO LOW to pump";
-    Serial.print("K");
-  }
-
-  Serial.println(); // End of Debug line
+  pumps.updateTimers();
+  pumps.evaluate(masterMode);
+  systemAnalysis = pumps[PUMP_PUBLIC_KLONG].decision.analysis;
 
-  if (publicKlong_PumpDecision == 1) {
-    startPump1();
-  } else {
-    stopPump1();
+  for (size_t i = 0; i < pumps.count(); i++) {
+    const Pump &pump = pumps[i];
+    if (!pump.config.enabled) continue;
+    TRACE(TRACE_LEVEL_INFO, TRACE_PUMP_DECISION, pump.config.name, pumpEventNames[(uint8_t)pump.decision.reason],
+          pumpStateNames[(uint8_t)pump.previous], pumpStateNames[(uint8_t)pump.state]);
   }
 
   // Send Water data over 433Mhz for statistics
@@ -624,301 +610,146 @@ void analyzeWaterLevels() {
 
 }
 
-void handleMasterOperationsChoice(String opsmode) {
-  if (opsmode == master_mode_forced_on) {
-    Serial.println("Switch the system to FORCED ON mode");
-    startPump1();
-  } else if (opsmode == master_mode_forced_off) {
-    Serial.println("Switch the system to FORCED OFF mode");
-    stopPump1();
+void handleMasterOperationsChoice(MasterMode mode) {
+  if (mode == MasterMode::ForcedOn) {
+    TRACE(TRACE_LEVEL_INFO, TRACE_MASTER_MODE, "FORCED ON");
+    for (size_t i = 0; i < pumps.count(); i++) pumps.start(i);
+  } else if (mode == MasterMode::ForcedOff) {
+    TRACE(TRACE_LEVEL_INFO, TRACE_MASTER_MODE, "FORCED OFF");
+    for (size_t i = 0; i < pumps.count(); i++) pumps.stop(i);
   } else {
-    Serial.println("Switch the system to AUTO mode");
-    // opsmode == master_mode_automated 
+    TRACE(TRACE_LEVEL_INFO, TRACE_MASTER_MODE, "AUTO");
+    // MasterMode::Auto
     // Do nothing here, the next Loop cycle will take care of everything
   }
 }
 
 
-const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML><html>
-<head>
-  <title>BKO Garden System</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <link rel="icon" href="data:,">
-  <style>
-    html {font-family: Arial; display: inline-block; text-align: center;}
-    h2 {font-size: 2.0rem;}
-    p {font-size: 3.0rem;}
-    body {max-width: 600px; margin:0px auto; padding-bottom: 25px;}
-    table {border-collapse: collapse;margin-left:auto;margin-right:auto;}
-    td, th {border: 1px solid #dddddd; text-align: left; padding: 8px;}
-    tr:nth-child(even) { background-color: #dddddd; }
-  </style>
-</head>
-<body>
-  <h2>BKO Garden System</h2>
-  %OPERATINGMODEPLACEHOLDER%
-  <br/>
-  %PUMPSTATUSPLACEHOLDER%
-  <br/>
-  %SYSTEMSTATUSPLACEHOLDER%
-  <br/>
-  %WATERLIMITPLACEHOLDER%
-  <br/>
-  %VERSIONPLACEHOLDER%
-  <br/>
-  %FIRMWAREPLACEHOLDER%
-<script>
-  var gateway = `ws://${window.location.hostname}/ws`;
-  var websocket;
-  window.addEventListener('load', onLoad);
-  function initWebSocket() {
-    console.log('Trying to open a WebSocket connection...');
-    websocket = new WebSocket(gateway);
-    websocket.onopen    = onOpen;
-    websocket.onclose   = onClose;
-    websocket.onmessage = onMessage; // <-- add this line
-  }
-  function onOpen(event) {
-    console.log('Connection opened');
-  }
-  function onClose(event) {
-    console.log('Connection closed');
-    setTimeout(initWebSocket, 2000);
-  }
-  function onMessage(event) {
-    console.log('WS On Message:' + event.data);
-    msg = JSON.parse(event.data)
-    var sensorLevel = msg.sensor;
-    var rawsensorlevel = msg.rawsensor;
-    var lastpkespnowmsg = msg.lastpkespnowmsg;
-    var frequency = msg.frequency;
-    var minlvl = msg.minlvl;
-    var opsmode = msg.opsmode;
-    var sysanalysis = msg.sysanalysis;
-    var powerpk = msg.powerpk;
-    var powerpktimer = msg.powerpktimer;
-    var timetoanalysis = msg.timetoanalysis;
-    var overheattimeleft = msg.overheattimeleft;
-    var overheatprotectiontime = msg.overheatprotectiontime;
-    var overheatprotectionactivated = msg.overheatprotectionactivated;
-    var overheatprotectionmaxruntime = msg.overheatprotectionmaxruntime;
-    document.getElementById('sensor').innerHTML = sensorLevel + "&nbsp;cm (" + lastpkespnowmsg + " sec&nbsp;ago)<br/>Raw: " + rawsensorlevel + "cm";
-    document.getElementById('frequency').innerHTML = frequency;
-    document.getElementById('minlvl').innerHTML = minlvl + " cm";
-    document.getElementById('opsmode').innerHTML = opsmode;
-    document.getElementById('sysanalysis').innerHTML = sysanalysis;
-    document.getElementById('timetoanalysis').innerHTML = timetoanalysis;
-    elempumpstatus = document.getElementById('pumpstatus');
-    elempumpstatusbar = document.getElementById('pumpstatusbar');
-    if (opsmode == "AUTO" && powerpk == 1) {
-      elempumpstatus.innerHTML = "ON (" + powerpktimer + " min)";
-      elempumpstatusbar.innerHTML = "<div style='width:280px;margin:auto;background:green;color:white;padding:5px 5px 5px 5px;'>Pumping</div><br/>";
-    } else if (opsmode == "AUTO" && powerpk == 0) {
-      elempumpstatus.innerHTML = "OFF";
-      elempumpstatusbar.innerHTML = "<div style='width:280px;margin:auto;background:red;color:white;padding:5px 5px 5px 5px;'>Not pumping</div><br/>";
-    } else if (opsmode == "FORCED OFF") {
-      elempumpstatus.innerHTML = "Forced OFF";
-      elempumpstatusbar.innerHTML = "<div style='width:280px;margin:auto;background:grey;color:white;padding:5px 5px 5px 5px;'>Forced Offline</div><br/>";
-    } else if (opsmode == "FORCED ON") {
-      elempumpstatus.innerHTML = "Forced ON (" + powerpktimer + " min)";
-      elempumpstatusbar.innerHTML = "<div style='width:280px;margin:auto;background:green;color:white;padding:5px 5px 5px 5px;'>Pumping (forced)</div><br/>";
-    } else {
-      elempumpstatus.innerHTML = "UNKNOWN MODE!!!";
-      elempumpstatusbar.innerHTML = "<div style='width:280px;margin:auto;background:green;color:white;padding:5px 5px 5px 5px;'>Forced Pumping</div><br/>";
-    }
-    var overheatprotectioninfo = "<span style='text-decoration: underline;'>Configuration:</span><br/>";
-    overheatprotectioninfo += "\u2022 " + overheatprotectionmaxruntime + " minutes on,<br/>";
-    overheatprotectioninfo += "\u2022 " + overheatprotectiontime + " minutes off.<br/>";
-    if (overheatprotectionactivated == 1) {
-      document.getElementById('overheatmaxtime').innerHTML = "" + overheatprotectioninfo + "<span style='color:red'>Active Overheat Protection<br/> time left: " + overheattimeleft + " sec.</span>";
-    } else {
-      document.getElementById('overheatmaxtime').innerHTML = "" + overheatprotectioninfo;
-    }
-  }
-
-  function onLoad(event) {
-    initWebSocket();
-    initButton();
-  }
-  function initButton() {
-    //document.getElementById('button').addEventListener('click', toggle);
-  }
-  function toggle(){
-    websocket.send('toggle');
-  }
-</script>  
-</body>
-</html>
-)rawliteral";
-
-// Replaces placeholder with button section in your web page
-String htmlProcessor(const String& var){
-  // Serial.print("HTML Processor for: ");
-  // Serial.println(var);
-
-  if (var == "VERSIONPLACEHOLDER"){
-    String version = "";
-    version += DEVICE_NAME + " (" + VERSION + ")<br/>";
-    return version;
-  }
-  
-  if (var == "OPERATINGMODEPLACEHOLDER"){
-    String html = "";
-    html += "Operating Mode: <span id='opsmode'>" + master_operations_mode + "</span><br/>";
-    html += "<a href='/mastermode?mode=on'>Force ON</a> ";
-    html += "<a href='/mastermode?mode=off'>Force OFF</a> ";
-    html += "<a href='/mastermode?mode=auto'>AUTO</a><br/>";
-    html += "<br/>";
-    return html;
-  }
-  
-  if (var == "WATERLIMITPLACEHOLDER"){
-    String html = "";
-    html += "<form action='/setmin'>";
-    html += "<label for='lvl'>Min Level:</label> ";
-    html += "<input type='text' style='width:30px' id='flvl' name='lvl' value='" + String(publicKlong_PumpMinimumWaterLevel) + "'> cm ";
-    html += "<input type='submit' value='Update'>";
-    html += "</form>";
-    return html;
-  }
-  
-  if (var == "PUMPSTATUSPLACEHOLDER"){
-    String html = "<span id='pumpstatusbar'>";
-    if  (publicKlong_PumpDecision == 1) {
-      html += "<div style='width:280px;margin:auto;background:green;color:white;padding:5px 5px 5px 5px;'>Pumping</div><br/>";
-    } else {
-      if ( master_operations_mode == master_mode_forced_off) {
-        html += "<div style='width:280px;margin:auto;background:grey;color:white;padding:5px 5px 5px 5px;'>SYSTEM OFFLINE</div><br/>";
-      } else {
-        html += "<div style='width:280px;margin:auto;background:red;color:white;padding:5px 5px 5px 5px;'>Not pumping</div><br/>";
-      }
-    }
-    html += "</span>";
-    return html;
-  }
-
-  if (var == "SYSTEMSTATUSPLACEHOLDER"){
-    String html = "";
-    html += "<table>";
-    html += "  <tr>";
-    html += "    <td>Frequency:</td>";
-    html += "    <td><span id='frequency'>" + String(getPreferredSensorRefreshFrequencyAsString()) + "</span> ";
-    html += "       <form action='/frequency'>";
-    html += "         <select name='freq' id='freq'>";
-    html += "           <option value='0'>1 sec</option>";
-    html += "           <option value='1'>5 sec</option>";
-    html += "           <option value='2'>10 sec</option>";
-    html += "           <option value='3'>15 sec</option>";
-    html += "           <option value='4'>30 sec</option>";
-    html += "           <option value='5'>1 min</option>";
-    html += "           <option value='6'>2 min</option>";
-    html += "           <option value='7'>5 min</option>";
-    html += "           <option value='8'>10 min</option>";
-    html += "           <option value='9'>15 min</option>";
-    html += "           <option value='10'>30 min</option>";
-    html += "           <option value='11'>45 min</option>";
-    html += "           <option value='12'>1 hr</option>";
-    html += "           <option value='13'>2 hrs</option>";
-    html += "         </select>";
-    html += "       <input type='submit' value='Set'>";
-    html += "     </form>";
-    html += "    </td>";
-    html += "  </tr>";
-    html += "  <tr>";
-    html += "    <td>Required:</td>";
-    html += "    <td id='minlvl'>" + String(publicKlong_PumpMinimumWaterLevel) + " cm</td>";
-    html += "  </tr>";
-    html += "  <tr>";
-    html += "    <td>Sensor:</td>";
-    html += "    <td id='sensor'>" + String(publicKlong_SensorWaterDistance) + "</td>";
-    html += "  </tr>";
-
-    html += "  <tr>";
-    html += "  <td>Pump:</td>";
-    html += "  <td id='pumpstatus'>";
-    if (publicKlong_PumpDecision == 1) {
-      if (master_operations_mode == master_mode_forced_on) {
-        html += "Forced ON";
-      } else {
-        html += "ON";
-      }
-      html += " (";
-      html += String(publicKlong_operating_time_min);
-      html += " min)";
-      html += "</td>";
-    } else {
-      if (master_operations_mode == master_mode_forced_off) {
-        html += "Forced OFF";
-      } else {
-        html += "OFF";
-      }
-      html += "</td>";
-    }
-    html += "  </tr>";
-
-    html += "  <tr>";
-    html += "    <td>Status:</td>";
-    html += "    <td id='sysanalysis'>" + systemAnalysis + "</td>";
-    html += "  </tr>";
-
-    html += "  <tr>";
-    html += "    <td>Overheat<br/>Protection:</td>";
-    html += "    <td id='overheatmaxtime'></td>";
-    html += "  </tr>";
-
-    html += "</table><br/>";
-
-    html += "Next Evaluation: <span id='timetoanalysis'></span><br/>";
-    return html;
-  }
-  
-  if (var == "FIRMWAREPLACEHOLDER") {
-    String html = "";
-    html += "Firmware: " + String(__DATE__) + " " + String(__TIME__) + "<br/>";
-    html += "<a href='/update'>Update Firmware</a><br/>";
-    html += "<a href='/reboot'>Reboot</a>";
-    return html;
-  }
-  
-  return String();
-}
+// The dashboard page (web/index.html) is static and embedded gzip compressed by
+// tools/embed_web.py at build time: it is sent as is, no template pass. All the
+// values shown come from the websocket (the first frame is a full snapshot).
+#include "dashboard_html.h"
 
 // WEBSOCKET functions
 // -------------------
+// WebSocket status updates carry only the fields changed since the last update
+// (compared at the precision sent), plus a full snapshot every STATUS_FULL_SNAPSHOT_TICKS
+// or when a client asks for it (new client, missed update). Every update has a
+// version "v" so the page can detect a missing one, and the device time "now" (ms)
+// that the page uses to compute countdowns from the timestamps (*ms fields).
+#define STATUS_FULL_SNAPSHOT_TICKS 30
+typedef struct StatusSnapshot {
+  float sensor;
+  float rawsensor;
+  int frequency;                        // Index of the frequency option selected
+  int minlvl;
+  char opsmode[12];
+  int powerpk;
+  float powerpktimer;
+  char sysanalysis[40];
+  unsigned long nextanalysisms;
+  unsigned long lastpkmsgms;
+  int overheatprotectionactivated;
+  unsigned long overheatendms;
+  int overheatprotectiontime;
+  int overheatprotectionmaxruntime;
+  int lowpower;                         // Low power mode enabled
+} StatusSnapshot;
+StatusSnapshot statusLastSent;
+uint32_t statusVersion = 0;
+int statusTicksSinceFullSnapshot = STATUS_FULL_SNAPSHOT_TICKS;
+volatile bool statusFullSnapshotRequested = true;
+
+// The status JSON is written straight into this preallocated buffer (no String, no heap)
+// It is only built when somebody is listening, once per tick and shared by all clients
+char statusJsonBuffer[1024];
+uint32_t statusSerializations = 0;
+uint32_t statusSerializationsSkipped = 0;   // Ticks without any client connected
+
+float roundToCentimeters(float value) {
+  return roundf(value * 100) / 100;
+}
+
 void notifyClients() {
+  MetricTimer timer(metricNotifyClients);
   // Serial.println("WebSocket: Notify Clients");
-  String json = "";
-  json += "{";
-  json += "\"sensor\":" + String(publicKlong_SensorWaterDistance);
-  json += ",\"rawsensor\":" + String(publicKlong_RawDataWaterDistance);
-  json += ",\"frequency\":\"" + String(getPreferredSensorRefreshFrequencyAsString()) + "\"";
-  json += ",\"minlvl\":\"" + String(publicKlong_PumpMinimumWaterLevel) + "\"";
-  json += ",\"opsmode\":\"" + master_operations_mode + "\"";
-  json += ",\"powerpk\":\"" + String(publicKlong_powered) + "\"";
-  json += ",\"powerpktimer\":\"" + String(publicKlong_operating_time_min) + "\"";
-  json += ",\"sysanalysis\":\"" + systemAnalysis + "\"";
-  json += ",\"timetoanalysis\":\"" + String(getPreferredSensorRefreshFrequencyInSeconds() - (millis() - waterSensorsLastReadTickerMS) / 1000) + "s\"";
-  json += ",\"lastpkespnowmsg\":\"" + String((millis() - waterSensorsPublicKlongLastDataReceivedMS) / 1000.0) + "\"";
-  if (publicKlong_overheat_protection_activated) {
-    json += ",\"overheattimeleft\":\"" + String((publicKlong_overheat_protection_time_off_minutes * 60) - ((millis() - publicKlong_overheat_protection_kickoff_ms) / 1000)) + "\"";
-  } else {
-    json += ",\"overheattimeleft\":\"0\"";
+  if (ws.count() == 0) {
+    statusSerializationsSkipped++;
+    return;
+  }
+  statusSerializations++;
+
+  StatusSnapshot current;
+  current.sensor = roundToCentimeters(publicKlong_SensorWaterDistance);
+  current.rawsensor = roundToCentimeters(publicKlong_RawDataWaterDistance);
+  current.frequency = waterSensorsReadFrequencySelected;
+  const Pump &publicKlongPump = pumps[PUMP_PUBLIC_KLONG];
+  current.minlvl = publicKlongPump.config.policy.minimumWaterLevelCm;
+  strlcpy(current.opsmode, masterModeName(masterMode), sizeof(current.opsmode));
+  current.powerpk = publicKlongPump.powered;
+  current.powerpktimer = roundToCentimeters(publicKlongPump.operatingTimeMin());
+  strlcpy(current.sysanalysis, systemAnalysis.c_str(), sizeof(current.sysanalysis));
+  current.nextanalysisms = waterSensorsLastReadTickerMS + getPreferredSensorRefreshFrequencyInSeconds() * 1000UL;
+  current.lastpkmsgms = waterSensorsPublicKlongLastDataReceivedMS;
+  current.overheatprotectionactivated = publicKlongPump.state == PumpState::Cooldown;
+  current.overheatendms = current.overheatprotectionactivated ? publicKlongPump.cooldownEndMs() : 0;
+  current.overheatprotectiontime = publicKlongPump.config.policy.cooldownMinutes;
+  current.overheatprotectionmaxruntime = publicKlongPump.config.policy.maxRuntimeMinutes;
+  current.lowpower = lowPowerModeEnabled;
+
+  bool full = statusFullSnapshotRequested || ++statusTicksSinceFullSnapshot >= STATUS_FULL_SNAPSHOT_TICKS;
+  if (full) {
+    statusFullSnapshotRequested = false;
+    statusTicksSinceFullSnapshot = 0;
+  }
+
+  JsonWriter json(statusJsonBuffer, sizeof(statusJsonBuffer));
+  json.add("v", (unsigned long)statusVersion++);
+  if (full) json.add("full", 1);
+  json.add("now", millis());
+  if (full) {
+    json.add("device", DEVICE_NAME.c_str());
+    json.add("version", VERSION.c_str());
+    json.add("firmware", __DATE__ " " __TIME__);
+    json.addRaw("freqopts", frequencyOptionsLabelsJson.text);
+    json.add("nvswrites", (unsigned long)settingsStore.lifetimeWrites());   // Flash wear monitoring
+  }
+  #define STATUS_NUMBER(field) if (full || current.field != statusLastSent.field) json.add(#field, current.field)
+  #define STATUS_TEXT(field) if (full || strcmp(current.field, statusLastSent.field) != 0) json.add(#field, current.field)
+  STATUS_NUMBER(sensor);
+  STATUS_NUMBER(rawsensor);
+  if (full || current.frequency != statusLastSent.frequency) json.add("frequency", getPreferredSensorRefreshFrequencyAsString());
+  STATUS_NUMBER(minlvl);
+  STATUS_TEXT(opsmode);
+  STATUS_NUMBER(powerpk);
+  STATUS_NUMBER(powerpktimer);
+  STATUS_TEXT(sysanalysis);
+  STATUS_NUMBER(nextanalysisms);
+  STATUS_NUMBER(lastpkmsgms);
+  STATUS_NUMBER(overheatprotectionactivated);
+  STATUS_NUMBER(overheatendms);
+  STATUS_NUMBER(overheatprotectiontime);
+  STATUS_NUMBER(overheatprotectionmaxruntime);
+  STATUS_NUMBER(lowpower);
+  #undef STATUS_NUMBER
+  #undef STATUS_TEXT
+  size_t len = json.end();
+  if (json.overflowed()) {
+    TRACE(TRACE_LEVEL_ERROR, TRACE_WS_JSON_OVERFLOW);
+    statusFullSnapshotRequested = true;
+    return;
   }
-  json += ",\"overheatprotectionactivated\":\"" + String(publicKlong_overheat_protection_activated) + "\"";
-  json += ",\"overheatprotectiontime\":\"" + String(publicKlong_overheat_protection_time_off_minutes) + "\"";
-  json += ",\"overheatprotectionmaxruntime\":\"" + String(publicKlong_overheat_protection_max_runtime_minutes) + "\"";
-  json += "}";
-  ws.textAll(json);
+  statusLastSent = current;
+  ws.textAll(statusJsonBuffer, len);
 }
 
 void handleWebSocketMessage(void *arg, uint8_t *data, size_t len) {
   AwsFrameInfo *info = (AwsFrameInfo*)arg;
   if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT) {
     data[len] = 0;
-    if (strcmp((char*)data, "toggle") == 0) {
+    if (strcmp((char*)data, "toggle") == 0 || strcmp((char*)data, "full") == 0) {
       // ledState = !ledState;
-      notifyClients();
+      statusFullSnapshotRequested = true;   // Sent with the next update from loop()
     }
   }
 }
@@ -927,10 +758,11 @@ void onEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType
              void *arg, uint8_t *data, size_t len) {
   switch (type) {
     case WS_EVT_CONNECT:
-      Serial.printf("WebSocket client #%u connected from %s\n", client->id(), client->remoteIP().toString().c_str());
+      TRACE(TRACE_LEVEL_INFO, TRACE_WS_CLIENT, client->id(), "connected");
+      statusFullSnapshotRequested = true;   // The new client needs everything
       break;
     case WS_EVT_DISCONNECT:
-      Serial.printf("WebSocket client #%u disconnected\n", client->id());
+      TRACE(TRACE_LEVEL_INFO, TRACE_WS_CLIENT, client->id(), "disconnected");
       break;
     case WS_EVT_DATA:
       handleWebSocketMessage(arg, data, len);
@@ -946,22 +778,10 @@ void initWebSocket() {
   server.addHandler(&ws);
 }
 
-bool handleSetOpsMode(String opsMode) {
-  if (opsMode == "on") master_operations_mode = master_mode_forced_on;
-  else if (opsMode == "off") master_operations_mode = master_mode_forced_off;
-  else if (opsMode == "auto") master_operations_mode = master_mode_automated;
-  else {
-    master_operations_mode = master_mode_forced_off;
-    return false;
-  }
-  int results = preferences.putString(prefMasterOperationsMode, master_operations_mode);
-  if (results == 0) {
-    Serial.println("Preferences: An error occured while saving Master Operations Mode");
-  } else {
-    Serial.print("Preferences: Master Operations Mode saved: ");
-    Serial.print(opsMode);
-  }      
-  return true;
+void handleSetOpsMode(MasterMode mode) {
+  masterMode = mode;
+  saveSettings();
+  TRACE(TRACE_LEVEL_INFO, TRACE_MASTER_MODE, masterModeName(mode));
 }
 
 // ***********************
@@ -977,15 +797,7 @@ void setup() {
   // IMMEDIATELY configure the PINs that control relays so they
   // are not turned ON too long while booting... (will flicker)
   // Configure Pump Relay and LED PINs
-  pinMode(PUBLIC_KLONG_RELAY_PIN, OUTPUT);
-  pinMode(PUBLIC_KLONG_RELAY_LED_PIN, OUTPUT);
-  digitalWrite(PUBLIC_KLONG_RELAY_PIN, HIGH);
-  digitalWrite(PUBLIC_KLONG_RELAY_LED_PIN, !digitalRead(PUBLIC_KLONG_RELAY_PIN));
-
-  pinMode(SOUTH_KLONG_RELAY_PIN, OUTPUT);
-  pinMode(SOUTH_KLONG_RELAY_LED_PIN, OUTPUT);
-  digitalWrite(SOUTH_KLONG_RELAY_PIN, HIGH);
-  digitalWrite(SOUTH_KLONG_RELAY_LED_PIN, !digitalRead(SOUTH_KLONG_RELAY_PIN));
+  setupPumps();
 
   // Onboard LED off by default
   pinMode(LED_BUILTIN, OUTPUT);
@@ -1042,13 +854,23 @@ void setup() {
   // Initialize OTA (Over-The-Air ElegantOTA system)
   // Start default webserver
   server.on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
-    request->send_P(200, "text/html", index_html, htmlProcessor);
+    // The page only changes with the firmware: browsers revalidate with its ETag
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == DASHBOARD_HTML_ETAG) {
+      request->send(304);
+      return;
+    }
+    AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", dashboard_html_gz, dashboard_html_gz_len);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", DASHBOARD_HTML_ETAG);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
     // request->send(200, "text/plain", "Hi! I am ESP32.");
   });
 
   // Support Reboot ESP32 from web page
   server.on("/reboot", HTTP_GET, [](AsyncWebServerRequest *request) {
     request->redirect("/");
+    saveBeforeReboot();
     delay(1000);
     ESP.restart();
   });
@@ -1056,17 +878,16 @@ void setup() {
   // Handle Set Frequency
   server.on("/frequency", HTTP_GET, [] (AsyncWebServerRequest *request) {
     Serial.print("Web request /frequency");
-    needRevaluationOfSituation = true;  // Always re-evaluate everything after a web page request
+    requestRevaluation();  // Always re-evaluate everything after a web page request
     String fq;
     if (request->hasParam("freq")) {
       fq = request->getParam("freq")->value();
+      if (!isValidFrequencyOption(fq.toInt())) {
+        request->send(200, "text/plain", "Invalid request: ?freq=xx is not a valid frequency option!");
+        return;
+      }
       waterSensorsReadFrequencySelected = fq.toInt();
-      int results = preferences.putInt(prefNameWaterSensorReadFrequency, waterSensorsReadFrequencySelected);
-      if (results == 0) {
-        Serial.println("Preferences: An error occured while saving Frequency settings");
-      } else {
-        Serial.println("Preferences: Frequency settings saved");
-      }     
+      saveSettings();
     }
     else {
       String msg = "Invalid request: ?freq=xx parameter is required!";
@@ -1081,43 +902,37 @@ void setup() {
   // Handle Set Master Operations Mode
   server.on("/mastermode", HTTP_GET, [] (AsyncWebServerRequest *request) {
     Serial.print("Web request /mastermode");
-    needRevaluationOfSituation = true;  // Always re-evaluate everything after a web page request
+    requestRevaluation();  // Always re-evaluate everything after a web page request
     String opsMode;
     if (request->hasParam("mode")) {
       opsMode = request->getParam("mode")->value();
       Serial.print("Web request /mastermode: ");
       Serial.println(opsMode);
-      if (!handleSetOpsMode(opsMode)) {
+      MasterMode mode;
+      if (!parseMasterMode(opsMode.c_str(), masterModeParams, mode)) {
         String msg = "INVALID REQUEST:  /mastermode?mode=xx Valid values are on / off / auto";
         request->send(200, "text/plain", msg);
         return;
       };
+      handleSetOpsMode(mode);
     }
     else {
       String msg = "Invalid request, ?mode=xx parameter is required!";
       request->send(200, "text/plain", msg);
       return;
     }
-    analyzeWaterLevels();
     request->redirect("/");
   });
 
   // Handle Set Minimum Water level required
   server.on("/setmin", HTTP_GET, [] (AsyncWebServerRequest *request) {
     Serial.print("Web request /setmin");
-    needRevaluationOfSituation = true;  // Always re-evaluate everything after a web page request
+    requestRevaluation();  // Always re-evaluate everything after a web page request
     String minLvl;
     if (request->hasParam("lvl")) {
       minLvl = request->getParam("lvl")->value();
-      publicKlong_PumpMinimumWaterLevel = minLvl.toInt();
-      int results = preferences.putInt(prefRequiredDistancePublicKlong, publicKlong_PumpMinimumWaterLevel);
-      if (results == 0) {
-        Serial.println("Preferences: An error occured while saving Minimum Water Level");
-      } else {
-        Serial.print("Preferences: Minimum Water Level saved: ");
-        Serial.println(minLvl);
-        Serial.print(" cm.");
-      }      
+      pumps[PUMP_PUBLIC_KLONG].config.policy.minimumWaterLevelCm = minLvl.toInt();
+      saveSettings();
     }
     else {
       String msg = "Invalid request: ?lvl=xx parameter is required!";
@@ -1129,6 +944,90 @@ void setup() {
     request->redirect("/");
   });
 
+  // History chart data: /history?from=&to=&points= (see include/history_stream.h)
+  // from / to: history clock seconds (default: the last 24h), a negative from is relative to to
+  server.on("/history", HTTP_GET, [] (AsyncWebServerRequest *request) {
+    long to = request->hasParam("to") ? request->getParam("to")->value().toInt() : history.now();
+    long from = request->hasParam("from") ? request->getParam("from")->value().toInt() : -86400;
+    long points = request->hasParam("points") ? request->getParam("points")->value().toInt() : HISTORY_DEFAULT_POINTS;
+    if (from < 0) from = to + from > 0 ? to + from : 0;
+    if (to <= from || points < 3 || points > HISTORY_MAX_POINTS) {
+      request->send(400, "text/plain", "INVALID REQUEST:  /history?from=s&to=s&points=3..2000");
+      return;
+    }
+    // Lives as long as the response (released by the server with the filler)
+    std::shared_ptr<HistoryCsvStream> stream = std::make_shared<HistoryCsvStream>(history, from, to, points, pumps.count());
+    AsyncWebServerResponse *response = request->beginChunkedResponse("text/csv", [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      return stream->fill(buffer, maxLen);
+    });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+  });
+
+#if METRICS_ENABLED
+  // Prometheus scrape: /metrics (see METRICS)
+  server.on("/metrics", HTTP_GET, [] (AsyncWebServerRequest *request) {
+    collectMetrics();
+    std::shared_ptr<MetricsTextStream> stream = std::make_shared<MetricsTextStream>();
+    AsyncWebServerResponse *response = request->beginChunkedResponse("text/plain; version=0.0.4", [stream](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      return stream->fill(buffer, maxLen);
+    });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+  });
+#endif
+
+  // 433Mhz remotes (see 433Mhz REMOTES): /learn?action=on|off|auto|none binds the next code
+  // received to the action, action=forget unbinds it, action=clear forgets all the learned codes.
+  // Without action: the learned codes
+  server.on("/learn", HTTP_GET, [] (AsyncWebServerRequest *request) {
+    if (!request->hasParam("action")) {
+      String list = "Learned 433Mhz codes: " + String(rfLearned.count()) + "/" + String(RF433_LEARNED_MAX) + "\n";
+      for (size_t i = 0; i < rfLearned.count(); i++) {
+        list += String(rfLearned[i].code) + " " + rfActionNames[(uint8_t)rfLearned[i].action] + "\n";
+      }
+      request->send(200, "text/plain", list);
+      return;
+    }
+    String name = request->getParam("action")->value();
+    RfAction action;
+    int learn;
+    if (name == "forget") learn = RF433_LEARN_FORGET;
+    else if (name == "clear") learn = RF433_LEARN_CLEAR;
+    else if (parseRfAction(name.c_str(), action)) learn = (int)action;
+    else {
+      request->send(400, "text/plain", "INVALID REQUEST:  /learn?action=on|off|auto|none|forget|clear");
+      return;
+    }
+    rfLearnRequestMS = millis();
+    rfLearnRequest = learn;
+    request->send(200, "text/plain", learn == RF433_LEARN_CLEAR ? "Forgetting all the learned codes" : "Press the remote button (30 seconds)");
+  });
+
+  // Handle Set Power Mode (low power: see LOW POWER MODE)
+  server.on("/powermode", HTTP_GET, [] (AsyncWebServerRequest *request) {
+    Serial.print("Web request /powermode");
+    requestRevaluation();  // Always re-evaluate everything after a web page request
+    String powerMode;
+    if (request->hasParam("mode")) {
+      powerMode = request->getParam("mode")->value();
+      if (powerMode != "low" && powerMode != "normal") {
+        request->send(200, "text/plain", "INVALID REQUEST:  /powermode?mode=xx Valid values are low / normal");
+        return;
+      }
+      lowPowerModeEnabled = powerMode == "low";
+      saveSettings();
+    }
+    else {
+      String msg = "Invalid request, ?mode=xx parameter is required!";
+      request->send(200, "text/plain", msg);
+      return;
+    }
+    Serial.print("Web request /powermode: ");
+    Serial.println(powerMode);
+    request->redirect("/");
+  });
+
   AsyncElegantOTA.begin(&server);    // Start ElegantOTA
   server.begin();
   Serial.println("HTTP server started");
@@ -1147,6 +1046,20 @@ void setup() {
 
   myRadioSignalSwitch.enableReceive(GPIO_RF_PIN);  // Receiver input on interrupt 0 (D2) OR D3???
   myRadioSignalSwitch.enableTransmit(GPIO_TRANSMIT_PIN);  
+  // 433Mhz transmissions: send() bit-bangs 325us pulses with delayMicroseconds(), a time slice
+  // given to another task in the middle corrupts the frame. Core 1 (loop(), idle almost all the
+  // time) above loop()'s priority: nothing preempts a frame, loop() waits for its end (~160ms)
+  startBackgroundService("rf433tx", transmitNextRF433MhzCode, 20, 4096, RF433_TX_PRIORITY, RF433_TX_CORE);
+  startBackgroundService("oled", flushOledDisplay, 1000, 4096, 1, 0);
+  startBackgroundService("trace", drainTraceLog, 50, 4096, 0, 0);   // Lowest priority: prints when nothing else runs
+  history.setFlushService(flushHistory);
+  if (history.begin()) {
+    startBackgroundService("history", flushHistory, 1000, 4096, 1, 0);
+    Serial.printf("History: %u minutes, %u hours, %u days at least\n", history.capacity(HISTORY_MINUTES),
+                  history.capacity(HISTORY_HOURS), history.capacity(HISTORY_DAYS));
+  } else {
+    Serial.println("History: SPIFFS mount failed, no history");
+  }
 
   // Confirgure Ultrasounic Distance/Meter Sensors Pins
   pinMode(sensorPublicKlong_trigPin, OUTPUT); // Sets the sensorPublicKlong_trigPin as an Output
@@ -1156,9 +1069,40 @@ void setup() {
 
   // Handle Preferences
   preferences.begin("bko_dmz_dev1", false);
-  waterSensorsReadFrequencySelected = preferences.getInt(prefNameWaterSensorReadFrequency, waterSensorsReadFrequencySelected);
-  publicKlong_PumpMinimumWaterLevel = preferences.getInt(prefRequiredDistancePublicKlong, prefRequiredDistancePublicKlong_default);
-  master_operations_mode = preferences.getString(prefMasterOperationsMode, master_operations_mode);
+  PersistentSettings settings;
+  if (settingsStore.load(settings)) {
+    waterSensorsReadFrequencySelected = settings.frequencyOption;
+    masterMode = isValidMasterMode(settings.masterMode) ? (MasterMode)settings.masterMode : MasterMode::Auto;
+    lowPowerModeEnabled = settings.lowPowerMode != 0;
+    pumps[PUMP_PUBLIC_KLONG].config.policy.minimumWaterLevelCm = settings.pumpMinimumWaterLevel;
+  } else {
+    // First boot with the settings blob: the older keys (or defaults) are migrated into it
+    waterSensorsReadFrequencySelected = preferences.getInt(prefNameWaterSensorReadFrequency, waterSensorsReadFrequencySelected);
+    pumps[PUMP_PUBLIC_KLONG].config.policy.minimumWaterLevelCm = preferences.getInt(prefRequiredDistancePublicKlong, prefRequiredDistancePublicKlong_default);
+    parseMasterMode(preferences.getString(prefMasterOperationsMode, masterModeName(masterMode)).c_str(), masterModeNames, masterMode);
+  }
+  if (!isValidFrequencyOption(waterSensorsReadFrequencySelected)) waterSensorsReadFrequencySelected = FREQUENCY_OPTION_DEFAULT;
+  Serial.print("Settings: NVS lifetime writes ");
+  Serial.println(settingsStore.lifetimeWrites());
+  rfLearned.load(preferences, prefRfLearned);
+  Serial.printf("433Mhz: %u learned codes\n", (unsigned)rfLearned.count());
+
+  // Tasks run by loop(), see SCHEDULER
+  taskButtons = scheduler.add("buttons", runButtonsTask);
+  taskPackets = scheduler.add("packets", processKlongDataPackets);
+  taskRadio433 = scheduler.add("radio433", runRadio433Task, RADIO433_POLL_MS);
+  taskTick = scheduler.add("tick", runTickTask, TICK_MS);
+  taskStats = scheduler.add("stats", sendStatistics, STATS_MS);
+  taskAnalysis = scheduler.add("analysis", runAnalysisTask);
+  taskSettings = scheduler.add("settings", runSettingsTask);
+  saveSettings();     // Only written if there was no settings blob yet
+  scheduleNextAnalysis();
+  scheduler.setIdleHook(powerAwareIdle);
+  // Buttons are not polled while nobody touches them: any edge wakes their task up
+  attachInterrupt(digitalPinToInterrupt(BUTTON_MENU_PIN), onButtonEdge, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_DEC_OPTIONS_PIN), onButtonEdge, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_INC_OPTIONS_PIN), onButtonEdge, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_CONFIRM_PIN), onButtonEdge, CHANGE);
 
   // Init ESP-NOW
   if (esp_now_init() != 0) {
@@ -1181,224 +1125,224 @@ void setup() {
 // Data Types are:
 //  1: Distance Measure (klong water level for example)
 //  2: Pump status
-void sendRF433MhzCode(int deviceid, int datatype, int value) {
+// The code is only queued here, it is sent later by the 433Mhz background
+// service (see transmitNextRF433MhzCode) so the caller is never blocked.
+void sendRF433MhzCode(int deviceid, int datatype, int value, uint8_t priority) {
+  MetricTimer timer(metricRf433Queue);
   // Check if parameters are acceptable
   if (    deviceid < 10 || deviceid > 99
        || datatype < 0  || datatype > 9
        || value < 0     || value > 999999 ) {
-    Serial.print("433Mhz: Out of range value! ");
-    Serial.print("DeviceID: ");
-    Serial.print(deviceid);
-    Serial.print("DataType: ");
-    Serial.print(datatype);
-    Serial.print("Value: ");
-    Serial.println(value);
+    TRACE(TRACE_LEVEL_WARN, TRACE_RF433_OUT_OF_RANGE, deviceid, datatype, value);
   }
   // Build the binary string for the final code
   uint32_t intValue = deviceid * 10000000 + datatype * 1000000 + value;
-  Serial.print("Sending 433Mhz code: ");
-  Serial.println(intValue);
+  if (!rf433TxQueue.push(intValue, priority)) {
+    TRACE(TRACE_LEVEL_WARN, TRACE_RF433_QUEUE_FULL, intValue);
+  }
+}
+
+// 433Mhz background service: send the next queued code, if any, once the radio is free.
+// Runs in its own task (see startBackgroundService), the send() itself blocks for ~160ms.
+// Returns true if a code was sent.
+bool transmitNextRF433MhzCode() {
+  if ((long)(millis() - rf433TxNextAllowedMS) < 0) return false;  // Still in the gap after the last transmission
+  uint32_t code;
+  if (!rf433TxQueue.pop(code)) return false;
+  MetricTimer timer(metricRf433Transmit);
+  rf433TxSending = true;
+  TRACE(TRACE_LEVEL_INFO, TRACE_RF433_SEND, code);
   myRadioSignalSwitch.setPulseLength(325);
   // myRadioSignalSwitch.setProtocol(1);
   myRadioSignalSwitch.setRepeatTransmit(3);
-  myRadioSignalSwitch.send(intValue, 32); 
-  delay(200);
+  myRadioSignalSwitch.send(code, 32);
+  rf433TxNextAllowedMS = millis() + RF433_TX_GAP_MS;
+  rf433LastSentCode = code;
+  rf433LastSentMS = millis();
+  rf433TxSending = false;
+  return true;
 }
 
 // Send RF Code over 433Mhz
-void sendRF433MhzPowerInfo(int on) {
-  if (on) { 
-    sendRF433MhzCode(DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_PWR, 2);
+void sendRF433MhzPowerInfo(const Pump &pump) {
+  if (pump.powered) { 
+    sendRF433MhzTelemetry(telemetryPublicKlongPower, DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_PWR, 2, RF433_PRIORITY_HIGH);
   } else { 
-    if (publicKlong_overheat_protection_activated) {
-      sendRF433MhzCode(DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_PWR, 1);
+    if (pump.state == PumpState::Cooldown) {
+      sendRF433MhzTelemetry(telemetryPublicKlongPower, DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_PWR, 1, RF433_PRIORITY_HIGH);
     } else {
-      sendRF433MhzCode(DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_PWR, 0);
+      sendRF433MhzTelemetry(telemetryPublicKlongPower, DATA_PACKET_DEVICE_ID_PK, DATA_PACKET_DATATYPE_PWR, 0, RF433_PRIORITY_HIGH);
     }
   }    
 }
 
 // Based on 433Mhz received code, get the name matching the command (code)
-String getCommandName(int v) {
-  // Phenix RM 2  (DIP: 01111)
-  if (v == 4195665) { return "PH2-A-ON"; }  else 
-  if (v == 4195668) { return "PH2-A-OFF"; } else
-  if (v == 4198737) { return "PH2-B-ON"; }  else
-  if (v == 4198740) { return "PH2-B-OFF"; } else
-  if (v == 4199505) { return "PH2-C-ON"; }  else
-  if (v == 4199508) { return "PH2-C-OFF"; } else
-  if (v == 4199697) { return "PH2-D-ON"; }  else
-  if (v == 4199700) { return "PH2-D-OFF"; } else
-  // Phenix RM 1  (DIP: 00000)
-  if (v == 5588305) { return "PH1-A-ON"; }  else 
-  if (v == 5588308) { return "PH1-A-OFF"; } else
-  if (v == 5591377) { return "PH1-B-ON"; }  else
-  if (v == 5591380) { return "PH1-B-OFF"; } else
-  if (v == 5592145) { return "PH1-C-ON"; }  else
-  if (v == 5592148) { return "PH1-C-OFF"; } else
-  if (v == 5592337) { return "PH1-D-ON"; }  else
-  if (v == 5592340) { return "PH1-D-OFF"; } else
-  { return "N/A"; }
+const char *getCommandName(uint32_t code) {
+  const RfCommand *command = rfRemoteTable.find(code);
+  if (command) return command->name;
+  return rfLearned.find(code) ? "LEARNED" : "N/A";
+}
+
+// OLED screens: static labels are drawn once when the screen is shown, then
+// only the value fields that changed are redrawn and flushed (see oled_screen.h)
+OledField oledPkAge = {18, SSD_L3, 8};
+OledField oledSensorDistance = {0, SSD_L4, 10};
+OledField oledMinimumLevel = {67, SSD_L4, 10};
+OledField oledFrequency = {24, SSD_L5, 6};
+OledField oledNextAnalysis = {103, SSD_L5, 5};
+OledField oledPumpStatus = {30, SSD_L6, 16};
+OledField oledSystemAnalysis = {0, SSD_L7, 21};
+OledField oledFrequencyCurrent = {54, 16, 7};
+OledField oledFrequencyNew = {54, 24, 7};
+
+// The frame is sent to the panel by the "oled" background service, loop() never
+// waits for the I2C transfer
+bool flushOledDisplay() {
+  return oled.flushPublished();
+}
+
+void showOledFrame() {
+  oled.publish();
+  wakeBackgroundService(flushOledDisplay);
 }
 
 void displayDeviceStatus(void) {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
+  if (oled.beginScreen(DISPLAY_MODE_OPERATIONS)) {
+    // Display Line 1: Device Identification and firmware version
+    display.setCursor(128 - (5 * PIXELS_PER_CHAR), SSD_L1);
+    display.print(VERSION);
+    display.setCursor(0, SSD_L1);
+    display.print("#");
+    display.print(DEVICE_NAME);
+
+    display.setCursor(0, SSD_L2);
+    display.print("MAC:");
+    display.print(WiFi.softAPmacAddress());
+
+    // Display Line 4: Water Levels (Headers)
+    display.setCursor(0, SSD_L3);
+    display.print("PK:");
+    display.setCursor(67, SSD_L3);
+    display.print("Required");
+
+    // Display Line 6: Time in seconds until next measure/action
+    display.setCursor(0, SSD_L5);
+    display.print("Fq: ");
+    display.setCursor(67, SSD_L5);
+    display.print("Next: ");
+
+    // Display Line 7: Pump Status
+    display.setCursor(0, SSD_L6);
+    display.print("Pump:");
+  }
 
-  // Display Line 1: Device Identification and firmware version
-  display.setCursor(128 - (5 * PIXELS_PER_CHAR), SSD_L1);
-  display.print(VERSION);
-  display.setCursor(0, SSD_L1);
-  display.print("#");
-  display.print(DEVICE_NAME);
-
-  display.setCursor(0, SSD_L2);
-  display.print("MAC:");
-  display.print(WiFi.softAPmacAddress());
-
-  // Display Line 4: Water Levels (Headers)
-  display.setCursor(0, SSD_L3);
-  display.print("PK:");
-  char buff[5];
-  sprintf_P(buff, PSTR("%.02f"), (millis() - waterSensorsPublicKlongLastDataReceivedMS) / 1000.0); //results like 23.500001
-  display.print(String(buff));
-  display.print("s");
-  display.setCursor(67, SSD_L3);
-  display.print("Required");
+  char buff[24];
+  snprintf(buff, sizeof(buff), "%.2fs", (millis() - waterSensorsPublicKlongLastDataReceivedMS) / 1000.0);
+  oled.print(oledPkAge, buff);
 
   // Display Line 5: Water Levels (Values)
-  display.setCursor(0, SSD_L4);
-  // display.print(southKlong_CurrentWaterLevel);
-  display.print(publicKlong_SensorWaterDistance);
-  display.print("cm");
-  display.setCursor(67, SSD_L4);
-  display.print(publicKlong_PumpMinimumWaterLevel);
-  display.print("cm");
-  
-  // Display Line 6: Time in seconds until next measure/action
-  display.setCursor(0, SSD_L5);
-  display.print("Fq: ");
-  display.print(getPreferredSensorRefreshFrequencyAsString());
-  display.setCursor(67, SSD_L5);
-  display.print("Next: ");
-  display.print(getPreferredSensorRefreshFrequencyInSeconds() - (millis() - waterSensorsLastReadTickerMS) / 1000);
-  display.print("s");
-
-  // Display Line 7: Pump Status
-  display.setCursor(0, SSD_L6);
-  display.print("Pump:");
-  if (publicKlong_PumpDecision == 1) {
-    if (master_operations_mode == master_mode_forced_on) {
-      display.print("F-ON");
+  snprintf(buff, sizeof(buff), "%.2fcm", publicKlong_SensorWaterDistance);
+  oled.print(oledSensorDistance, buff);
+  const Pump &publicKlongPump = pumps[PUMP_PUBLIC_KLONG];
+  snprintf(buff, sizeof(buff), "%dcm", (int)publicKlongPump.config.policy.minimumWaterLevelCm);
+  oled.print(oledMinimumLevel, buff);
+
+  oled.print(oledFrequency, getPreferredSensorRefreshFrequencyAsString());
+  snprintf(buff, sizeof(buff), "%lds", (long)(getPreferredSensorRefreshFrequencyInSeconds() - (millis() - waterSensorsLastReadTickerMS) / 1000));
+  oled.print(oledNextAnalysis, buff);
+
+  if (publicKlongPump.powered) {
+    const char *state = "ON (A)";
+    if (masterMode == MasterMode::ForcedOn) {
+      state = "F-ON";
       systemAnalysis = "*** Pump FORCED ON";
-    } else {
-      display.print("ON (A)");
     }
-    display.setCursor(64, SSD_L6);
-    display.print(" ");
-    display.print(publicKlong_operating_time_min);
-    display.print(" min");
+    snprintf(buff, sizeof(buff), "%-6s %.2f min", state, publicKlongPump.operatingTimeMin());
+    oled.print(oledPumpStatus, buff);
   } else {
-    if (master_operations_mode == master_mode_forced_off) {
-      display.print("F-OFF");
+    if (masterMode == MasterMode::ForcedOff) {
+      oled.print(oledPumpStatus, "F-OFF");
       systemAnalysis = "*** FORCE OFFLINE";
     } else {
-      display.print("OFF (AUTO)");
+      oled.print(oledPumpStatus, "OFF (AUTO)");
     }
   }
 
-  // display.print("Mode:");
-  // display.print("AUTO");
-  
   // Display Line 8: Timers & Operating Mode / Menu
-  display.setCursor(0, SSD_L7);
-  display.print(systemAnalysis);
-  display.setCursor(64, SSD_L7);
-  // display.print("254 min");
-
-  // Refresh the display
-  display.display();
+  oled.print(oledSystemAnalysis, systemAnalysis.c_str());
 
+  // Refresh the display (only what changed, from the background)
+  showOledFrame();
 }
 
 void displayWifiStatus(void) {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
-
-  display.setCursor(128 - (5 * PIXELS_PER_CHAR), SSD_L1);
-  display.print(VERSION);
-  display.setCursor(0, SSD_L1);
-  display.print("#");
-  display.print(DEVICE_NAME);
-
-  display.setCursor(0, SSD_L2);
-  display.print("WIFI Mode: ");
-  display.println(wifimode);
-  display.println("Name:");
-  display.println(ssid);
-  #ifdef DEV_WIFI_MODE_AP
-    display.println("Pwd:");
-    display.println(password);
-  #endif
-  display.print("IP:");
-  display.println(IP.toString());
+  if (oled.beginScreen(DISPLAY_MODE_WIFI)) {
+    display.setCursor(128 - (5 * PIXELS_PER_CHAR), SSD_L1);
+    display.print(VERSION);
+    display.setCursor(0, SSD_L1);
+    display.print("#");
+    display.print(DEVICE_NAME);
+
+    display.setCursor(0, SSD_L2);
+    display.print("WIFI Mode: ");
+    display.println(wifimode);
+    display.println("Name:");
+    display.println(ssid);
+    #ifdef DEV_WIFI_MODE_AP
+      display.println("Pwd:");
+      display.println(password);
+    #endif
+    display.print("IP:");
+    display.println(IP.toString());
+  }
 
-  display.display();
+  showOledFrame();
 }
 
 void displayFrequencySetup(void) {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
-
-  display.setCursor(0, SSD_L1);
-  display.println("Frequency Setup:");
-  display.println("");
-  display.print("Current: ");
-  display.println(getPreferredSensorRefreshFrequencyAsString());
-  display.print("New:     ");
-  display.println(getPreferredSensorRefreshFrequencyAsString(waterSensorsReadFrequencySelection));
-  display.println("");
-  display.println("Change: -/+ buttons");
-  display.println("Save: CONFIRM button");
+  if (oled.beginScreen(DISPLAY_MODE_FREQUENCY_SETUP)) {
+    display.setCursor(0, SSD_L1);
+    display.println("Frequency Setup:");
+    display.println("");
+    display.println("Current: ");
+    display.println("New:     ");
+    display.println("");
+    display.println("Change: -/+ buttons");
+    display.println("Save: CONFIRM button");
+  }
+  oled.print(oledFrequencyCurrent, getPreferredSensorRefreshFrequencyAsString());
+  oled.print(oledFrequencyNew, getPreferredSensorRefreshFrequencyAsString(waterSensorsReadFrequencySelection));
 
-  display.display();
+  showOledFrame();
 }
 
 void displayInvalidDisplayMode(void) {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
-
-  display.setCursor(0, SSD_L1);
-  display.println("INVALID");
-  display.println("DISPLAY");
-  display.println("MODE!");
-  display.println(" ");
-  display.println("Press button again!");
+  if (oled.beginScreen(DISPLAY_MODE)) {
+    display.setCursor(0, SSD_L1);
+    display.println("INVALID");
+    display.println("DISPLAY");
+    display.println("MODE!");
+    display.println(" ");
+    display.println("Press button again!");
+  }
 
-  display.display();
+  showOledFrame();
 }
 
 void displayRebootMenu(void) {
-  display.clearDisplay();
-  display.setTextSize(1);
-  display.setTextColor(SSD1306_WHITE);
+  if (oled.beginScreen(DISPLAY_MODE_REBOOT)) {
+    display.setCursor(0, SSD_L1);
+    display.println("System Reboot");
+    display.println("");
+    display.println("");
+    display.println("CONFIRM to reboot");
+  }
 
-  display.setCursor(0, SSD_L1);
-  display.println("System Reboot");
-  display.println("");
-  display.println("");
-  display.println("CONFIRM to reboot");
-  
-  display.display();
+  showOledFrame();
 }
 
 void displaySplashScreen(void) {
-  display.clearDisplay();
-  display.setTextColor(SSD1306_WHITE);
+  oled.beginScreen(DISPLAY_SCREEN_SPLASH);
 
   display.setCursor(0, 0);
   display.setTextSize(2);
@@ -1409,11 +1353,13 @@ void displaySplashScreen(void) {
   display.println();
   display.print(VERSION);
 
-  display.display();
+  oled.flush();
   Serial.println("Waiting for Slash Screen on LCD display");
 }
 
 void updateDisplay(void) {
+  MetricTimer timer(metricUpdateDisplay);
+  if (lowPowerActive) return;   // Display off
   if (DISPLAY_MODE == DISPLAY_MODE_OPERATIONS) displayDeviceStatus();
   else if (DISPLAY_MODE == DISPLAY_MODE_WIFI) displayWifiStatus();
   else if (DISPLAY_MODE == DISPLAY_MODE_FREQUENCY_SETUP) displayFrequencySetup();
@@ -1457,16 +1403,16 @@ void printAllDeviceDataToSerial() {
   Serial.print(" Level: ");
   Serial.print(publicKlong_CurrentWaterLevel);
   Serial.print(" Pump: ");
-  if (publicKlong_PumpDecision == 1) {
+  if (pumps[PUMP_PUBLIC_KLONG].powered) {
     Serial.print("ON");
     Serial.print(" ");
-    Serial.print(publicKlong_operating_time_min);
+    Serial.print(pumps[PUMP_PUBLIC_KLONG].operatingTimeMin());
     Serial.print(" min");
   } else {
     Serial.print("OFF");
   }
   Serial.print(" Mode:");
-  Serial.print("AUTO");
+  Serial.print(masterModeName(masterMode));
   Serial.print(" Analysis: ");
   Serial.print(systemAnalysis);
   Serial.print(" Timer: ");
@@ -1518,29 +1464,32 @@ static char * dec2binWzerofill(unsigned long Dec, unsigned int bitLength) {
   return bin;
 }
 
+// Received 433Mhz code: only traced here, the binary / tri-state forms are built when the
+// trace is printed (formatRF433Received). Raw pulses (2 per bit + sync) at debug level, 3 per record
 void debugRF433MhzOutput(unsigned long decimal, unsigned int length, unsigned int delay, unsigned int* raw, unsigned int protocol) {
-  const char* b = dec2binWzerofill(decimal, length);
-  Serial.print("Decimal: ");
-  Serial.print(decimal);
-  Serial.print(" (");
-  Serial.print( length );
-  Serial.print("Bit) Binary: ");
-  Serial.print( b );
-  Serial.print(" Tri-State: ");
-  Serial.print( bin2tristate( b) );
-  Serial.print(" PulseLength: ");
-  Serial.print(delay);
-  Serial.print(" microseconds");
-  Serial.print(" Protocol: ");
-  Serial.println(protocol);
-  
-  Serial.print("Raw data: ");
-  for (unsigned int i=0; i<= length*2; i++) {
-    Serial.print(raw[i]);
-    Serial.print(",");
+  TRACE(TRACE_LEVEL_INFO, TRACE_RF433_RECEIVED, decimal, length, delay, protocol);
+  for (unsigned int i = 0; i <= length * 2; i += 3) {
+    TRACE(TRACE_LEVEL_DEBUG, TRACE_RF433_RAW, i, raw[i], raw[i + 1], raw[i + 2]);
   }
-  Serial.println();
-  Serial.println();
+}
+
+void formatRF433Received(const TraceRecord &record, char *out, size_t size) {
+  unsigned int length = record.args[1] < 32 ? record.args[1] : 32;
+  const char* b = dec2binWzerofill(record.args[0], length);
+  snprintf(out, size, "Decimal: %lu (%uBit) Binary: %s Tri-State: %s PulseLength: %u microseconds Protocol: %u\n",
+           (unsigned long)record.args[0], length, b, bin2tristate(b), (unsigned)record.args[2], (unsigned)record.args[3]);
+}
+
+// Trace background service: prints what the hot paths traced (see TRACE LOG)
+bool drainTraceLog() {
+  char line[160];
+  int printed = 0;
+  while (printed < 8 && traceLog.drain(traceEvents, sizeof(traceEvents) / sizeof(traceEvents[0]), line, sizeof(line))) {
+    Serial.print(line);
+    printed++;
+  }
+  metricTraceDropped.set(traceLog.dropped());
+  return printed > 0;
 }
 
 
@@ -1580,19 +1529,38 @@ void getWaterSensorsData() {
   // southKlong_SensorWaterDistance = duration * SOUND_SPEED/2;
 }
 
-void loop() {
+// SCHEDULER TASKS
+// ---------------
+void IRAM_ATTR onButtonEdge() {
+  buttonsLastEdgeMS = millis();
+  scheduler.wakeFromISR(taskButtons);
+}
+
+// Woken up by a button edge, then polls until the buttons are left alone
+void runButtonsTask() {
+  if (lowPowerActive) updatePowerMode();    // Somebody is here: wake up
   btnMenu.check();
   btnDecOptions.check();
   btnIncOptions.check();
   btnConfirm.check();
-  ws.cleanupClients();
+  if (millis() - buttonsLastEdgeMS < BUTTONS_ACTIVE_MS) {
+    scheduler.runIn(taskButtons, BUTTONS_POLL_MS);
+  } else {
+    scheduler.park(taskButtons);
+  }
+}
 
-  // Handle 433Mhz Communication Events
+// Handle 433Mhz Communication Events (RCSwitch decodes in its interrupt, we only pick the result)
+void runRadio433Task() {
+  if (rfLearnRequest == RF433_LEARN_CLEAR) {
+    rfLearned.clear(preferences, prefRfLearned);
+    rfLearnRequest = RF433_LEARN_OFF;
+    TRACE(TRACE_LEVEL_INFO, TRACE_RF433_LEARN, 0, "all codes forgotten");
+  }
   if (myRadioSignalSwitch.available()) {
     lastRFvalue = myRadioSignalSwitch.getReceivedValue();
     debugRF433MhzOutput(myRadioSignalSwitch.getReceivedValue(), myRadioSignalSwitch.getReceivedBitlength(), myRadioSignalSwitch.getReceivedDelay(), myRadioSignalSwitch.getReceivedRawdata(), myRadioSignalSwitch.getReceivedProtocol());
-    // if (lastRFvalue == RM2_A_ON)  { delay(800); digitalWrite(LED_BUILTIN, HIGH); sendRF433MhzPowerInfo(true); }
-    // if (lastRFvalue == RM2_A_OFF) { delay(800); digitalWrite(LED_BUILTIN, LOW);  sendRF433MhzPowerInfo(false); }
+    handleRF433Code(myRadioSignalSwitch.getReceivedValue());
     delay(1);
     myRadioSignalSwitch.resetAvailable();
   }
@@ -1600,56 +1568,189 @@ void loop() {
   if (lastRFvalue != previousRFvalue) {
     previousRFvalue = lastRFvalue;
   }
+}
 
-  // Do watever needed every second
-  // ------------------------------
-  if ((millis() - previousMS) > 1000) {
-    previousMS = millis();
-    // printAllDeviceDataToSerial();
-    getWaterSensorsData();
-    calculateWaterLevels();
-    updatePumpTimers();
-    updateDisplay();
-    notifyClients();
+// Received 433Mhz code: bound to a learned action first, then to a built-in remote button.
+// While /learn waits for a code, the code is learned (or forgotten) instead
+void handleRF433Code(uint32_t code) {
+  static uint32_t lastCode = 0;
+  static unsigned long lastCodeMS = 0;
+  bool repeated = code == lastCode && millis() - lastCodeMS < RF433_COMMAND_DEBOUNCE_MS;
+  lastCode = code;
+  lastCodeMS = millis();
+  if (repeated) return;
+
+  int learn = rfLearnRequest;
+  if ((learn >= 0 || learn == RF433_LEARN_FORGET) && millis() - rfLearnRequestMS < RF433_LEARN_TIMEOUT_MS) {
+    // Our own telemetry is on air every few seconds: never bound, /learn keeps waiting for the remote
+    bool ownCode = code >= RF433_TELEMETRY_MIN_CODE || (code == rf433LastSentCode && millis() - rf433LastSentMS < RF433_OWN_ECHO_MS);
+    if (ownCode) {
+      TRACE(TRACE_LEVEL_INFO, TRACE_RF433_LEARN, code, "ignored, our own telemetry");
+      return;
+    }
+    rfLearnRequest = RF433_LEARN_OFF;
+    if (learn == RF433_LEARN_FORGET) {
+      rfLearned.forget(code, preferences, prefRfLearned);
+      TRACE(TRACE_LEVEL_INFO, TRACE_RF433_LEARN, code, "forgotten");
+    } else if (learn >= 0 && rfLearned.learn(code, (RfAction)learn, preferences, prefRfLearned)) {
+      TRACE(TRACE_LEVEL_INFO, TRACE_RF433_LEARN, code, rfActionNames[learn]);
+    } else {
+      TRACE(TRACE_LEVEL_WARN, TRACE_RF433_LEARN, code, "not learned, table full");
+    }
+    return;
   }
 
-  // Statistics and other things every 5 seconds
-  if ((millis() - previousStatsMS) > 5000) {
-    previousStatsMS = millis();
-    sendStatistics();
+  const LearnedRemotes<RF433_LEARNED_MAX>::Entry *learned = rfLearned.find(code);
+  const RfCommand *command = learned ? nullptr : rfRemoteTable.find(code);
+  if (!learned && !command) return;     // Unknown code (our own telemetry included)
+  RfAction action = learned ? learned->action : command->action;
+  TRACE(TRACE_LEVEL_INFO, TRACE_RF433_COMMAND, code, command ? command->name : "learned", rfActionNames[(uint8_t)action]);
+  switch (action) {
+    case RfAction::PumpsOn:   handleSetOpsMode(MasterMode::ForcedOn); break;
+    case RfAction::PumpsOff:  handleSetOpsMode(MasterMode::ForcedOff); break;
+    case RfAction::PumpsAuto: handleSetOpsMode(MasterMode::Auto); break;
+    case RfAction::None:      return;
   }
+  requestRevaluation();
+}
 
-  // Handle the Timer for Water Sensor analysis & Decision
-  // based on preferred frequency settings
-  // -----------------------------------------------------
-  if ((millis() - waterSensorsLastReadTickerMS) > getPreferredSensorRefreshFrequencyInSeconds() * 1000
-      || needRevaluationOfSituation) {
-    waterSensorsLastReadTickerMS = millis();
-    needRevaluationOfSituation = false;
-    Serial.print("Time for analysis! ");
-    Serial.print("Frequency: ");
-    Serial.print(getPreferredSensorRefreshFrequencyAsString());
-    Serial.print("  Elasped: ");
-    Serial.print((millis() - waterSensorsLastReadTickerMS));
-    Serial.println();
-    // Distance Sensor measurement
-    // ***************************
-    getWaterSensorsData();
-    calculateWaterLevels();
-    analyzeWaterLevels();
+// Do watever needed every second
+void runTickTask() {
+  ws.cleanupClients();
+  updatePowerMode();
+  // printAllDeviceDataToSerial();
+  getWaterSensorsData();
+  calculateWaterLevels();
+  pumps.updateTimers();
+  history.sample(publicKlong_SensorWaterDistance, pumps.poweredMask());
+  updateDisplay();
+  notifyClients();
+}
+
+// Water Sensor analysis & Decision, based on preferred frequency settings
+// (or right away when woken up by requestRevaluation())
+void runAnalysisTask() {
+  updatePowerMode();                        // A new frequency (web, buttons) can rule the low power mode out
+  waterSensorsLastReadTickerMS = millis();
+  TRACE(TRACE_LEVEL_INFO, TRACE_ANALYSIS_START, getPreferredSensorRefreshFrequencyAsString());
+  // Distance Sensor measurement
+  // ***************************
+  getWaterSensorsData();
+  calculateWaterLevels();
+  analyzeWaterLevels();
+  updateDisplay();
+  if (lowPowerActive) sendStatistics();     // Telemetry batch (the stats task is parked)
+  scheduleNextAnalysis();
+}
+
+// Re-evaluate everything as soon as possible (settings changed...)
+void requestRevaluation() {
+  scheduler.wake(taskAnalysis);
+}
+
+// Next analysis one period after the last one (call it when the frequency changes)
+void scheduleNextAnalysis() {
+  unsigned long periodMS = getPreferredSensorRefreshFrequencyInSeconds() * 1000UL;
+  unsigned long elapsedMS = millis() - waterSensorsLastReadTickerMS;
+  scheduler.runIn(taskAnalysis, elapsedMS < periodMS ? periodMS - elapsedMS : 0);
+}
+
+// LOW POWER MODE (see its settings)
+bool lowPowerAllowed() {
+  return lowPowerModeEnabled
+         && getPreferredSensorRefreshFrequencyInSeconds() >= LOW_POWER_MIN_FREQUENCY_SECONDS
+         && ws.count() == 0
+         && millis() - buttonsLastEdgeMS >= LOW_POWER_AFTER_INPUT_MS
+         && !pumps.anyPowered();      // Pump timers / overheat protection need the tick
+}
+
+void updatePowerMode() {
+  bool allowed = lowPowerAllowed();
+  if (allowed == lowPowerActive) return;
+  lowPowerActive = allowed;
+  if (lowPowerActive) {
+    TRACE(TRACE_LEVEL_INFO, TRACE_POWER_MODE, "entering low power mode");
+    display.ssd1306_command(SSD1306_DISPLAYOFF);
+    myRadioSignalSwitch.disableReceive();
+    scheduler.park(taskRadio433);
+    scheduler.park(taskStats);
+    scheduler.setPeriod(taskTick, LOW_POWER_TICK_MS);
+  } else {
+    TRACE(TRACE_LEVEL_INFO, TRACE_POWER_MODE, "back to normal mode");
+    display.ssd1306_command(SSD1306_DISPLAYON);
+    myRadioSignalSwitch.enableReceive(GPIO_RF_PIN);
+    scheduler.setPeriod(taskRadio433, RADIO433_POLL_MS);
+    scheduler.setPeriod(taskStats, STATS_MS);
+    scheduler.setPeriod(taskTick, TICK_MS);
     updateDisplay();
   }
+}
+
+// Scheduler idle hook: light sleep while in low power mode, unless it is time to
+// listen to the sensor (before the next analysis) or a 433Mhz code is being sent
+void powerAwareIdle(uint32_t maxMs) {
+  loopBusyTimer.stop();   // Busy part of the loop() pass only
+  if (lowPowerActive && rf433TxQueue.pending() == 0 && !rf433TxSending) {
+    unsigned long periodMS = getPreferredSensorRefreshFrequencyInSeconds() * 1000UL;
+    // Frequency changed since the last updatePowerMode(): the period can be shorter than the listen time
+    unsigned long listenAtMS = periodMS > LOW_POWER_LISTEN_MS ? periodMS - LOW_POWER_LISTEN_MS : 0;
+    unsigned long sinceAnalysisMS = millis() - waterSensorsLastReadTickerMS;
+    if (sinceAnalysisMS + LOW_POWER_MIN_SLEEP_MS <= listenAtMS && maxMs >= LOW_POWER_MIN_SLEEP_MS) {
+      unsigned long sleepMs = listenAtMS - sinceAnalysisMS;
+      if (sleepMs > maxMs) sleepMs = maxMs;
+      if (lightSleep(sleepMs, buttonPins, sizeof(buttonPins))) {
+        buttonsLastEdgeMS = millis();
+        scheduler.wake(taskButtons);
+      }
+      return;
+    }
+  }
+  idleWait(maxMs);
+}
+
+// SETTINGS
+// Any task (web handler, button): the settings task writes them once they settle
+void saveSettings() {
+  PersistentSettings settings = {};
+  settings.frequencyOption = waterSensorsReadFrequencySelected;
+  settings.masterMode = (uint8_t)masterMode;
+  settings.lowPowerMode = lowPowerModeEnabled;
+  settings.pumpMinimumWaterLevel = pumps[PUMP_PUBLIC_KLONG].config.policy.minimumWaterLevelCm;
+  if (settingsStore.set(settings)) scheduler.wake(taskSettings);
+}
+
+void runSettingsTask() {
+  uint32_t writes = settingsStore.writes();
+  uint32_t waitMs = settingsStore.commitIfDue();
+  if (waitMs > 0) {
+    scheduler.runIn(taskSettings, waitMs);
+  } else if (settingsStore.writes() != writes) {
+    TRACE(TRACE_LEVEL_INFO, TRACE_SETTINGS_SAVED, settingsStore.lifetimeWrites());
+  }
+}
 
+// Before a reboot: settings changed in the last seconds and the history still in RAM are not lost
+void saveBeforeReboot() {
+  settingsStore.commit();
+  history.requestFlush();
+  for (int waitedMs = 0; history.flushPending() && waitedMs < 2000; waitedMs += 10) delay(10);
+}
+
+void loop() {
+  loopBusyTimer.start();
+  scheduler.run();
+  loopBusyTimer.stop();   // When the scheduler did not idle
 }
 
 
 
 // MENU button has some event to look into...
 void btnMenuEvent(AceButton* button, uint8_t eventType, uint8_t buttonState) {
-  Serial.println("MENU: ");
+  TRACE(TRACE_LEVEL_DEBUG, TRACE_BUTTON_EVENT, "MENU", eventType);
   switch (eventType) {
     case AceButton::kEventClicked:
-      Serial.println("CLICK");
+      oled.markInput();   // For the button-to-screen latency
+      TRACE(TRACE_LEVEL_INFO, TRACE_BUTTON_CLICK, "MENU");
       switchToNextDisplayMode();
       break;
   }
@@ -1657,27 +1758,22 @@ void btnMenuEvent(AceButton* button, uint8_t eventType, uint8_t buttonState) {
 
 // DEC/OPTIONS button has some event to look into...
 void btnDecOptionsEvent(AceButton* button, uint8_t eventType, uint8_t buttonState) {
-  Serial.print("DEC_OPTIONS: ");
+  TRACE(TRACE_LEVEL_DEBUG, TRACE_BUTTON_EVENT, "DEC_OPTIONS", eventType);
   switch (eventType) {
     case AceButton::kEventClicked:
-      Serial.println("CLICK");
+      oled.markInput();   // For the button-to-screen latency
+      TRACE(TRACE_LEVEL_INFO, TRACE_BUTTON_CLICK, "DEC_OPTIONS");
       if (DISPLAY_MODE == DISPLAY_MODE_FREQUENCY_SETUP) {
-        Serial.print("SizeOf[]: ");
-        Serial.println(sizeof(waterSensorsReadFrequencyOptions) / sizeof(waterSensorsReadFrequencyOptions[0]));
         if (waterSensorsReadFrequencySelection > 0) {
           waterSensorsReadFrequencySelection--;
         } else {
-          waterSensorsReadFrequencySelection = sizeof(waterSensorsReadFrequencyOptions) / sizeof(waterSensorsReadFrequencyOptions[0])-1;
+          waterSensorsReadFrequencySelection = FREQUENCY_OPTIONS_COUNT - 1;
         }
-        Serial.print(waterSensorsReadFrequencySelected);
-        Serial.print("->");
-        Serial.println(waterSensorsReadFrequencySelection);
+        TRACE(TRACE_LEVEL_INFO, TRACE_FREQUENCY_SELECTION, waterSensorsReadFrequencySelected, waterSensorsReadFrequencySelection);
         updateDisplay();
       } 
       if (DISPLAY_MODE == DISPLAY_MODE_OPERATIONS) {
-          if (!handleSetOpsMode("off")) {
-          Serial.println("Something went wrong. Valid values are on / off / auto");
-          }
+          handleSetOpsMode(MasterMode::ForcedOff);
       }
       break;
   }
@@ -1685,12 +1781,13 @@ void btnDecOptionsEvent(AceButton* button, uint8_t eventType, uint8_t buttonStat
 
 // INC/OPTIONS button has some event to look into...
 void btnIncOptionsEvent(AceButton* button, uint8_t eventType, uint8_t buttonState) {
-  Serial.print("INC_OPTIONS:");
+  TRACE(TRACE_LEVEL_DEBUG, TRACE_BUTTON_EVENT, "INC_OPTIONS", eventType);
   switch (eventType) {
     case AceButton::kEventClicked:
-      Serial.println("CLICK");
+      oled.markInput();   // For the button-to-screen latency
+      TRACE(TRACE_LEVEL_INFO, TRACE_BUTTON_CLICK, "INC_OPTIONS");
       if (DISPLAY_MODE == DISPLAY_MODE_FREQUENCY_SETUP) {
-        if (waterSensorsReadFrequencySelection < (sizeof(waterSensorsReadFrequencyOptions) / sizeof(waterSensorsReadFrequencyOptions[0]))-1) {
+        if (waterSensorsReadFrequencySelection < FREQUENCY_OPTIONS_COUNT - 1) {
           waterSensorsReadFrequencySelection++;
         } else {
           waterSensorsReadFrequencySelection = 0;
@@ -1698,9 +1795,7 @@ void btnIncOptionsEvent(AceButton* button, uint8_t eventType, uint8_t buttonStat
         updateDisplay();
       }
       if (DISPLAY_MODE == DISPLAY_MODE_OPERATIONS) {
-          if (!handleSetOpsMode("on")) {
-          Serial.println("Something went wrong. Valid values are on / off / auto");
-          }
+          handleSetOpsMode(MasterMode::ForcedOn);
       }
       break;
   }
@@ -1708,27 +1803,23 @@ void btnIncOptionsEvent(AceButton* button, uint8_t eventType, uint8_t buttonStat
 
 // CONFIRM/CANCEL button clicked, action depends on current screen displayed
 void btnConfirmEvent(AceButton* button, uint8_t eventType, uint8_t buttonState) {
-  Serial.print("CONFIRM/CANCEL: ");
+  TRACE(TRACE_LEVEL_DEBUG, TRACE_BUTTON_EVENT, "CONFIRM/CANCEL", eventType);
   switch (eventType) {
     case AceButton::kEventClicked:
-      Serial.println("CLICK");
+      oled.markInput();   // For the button-to-screen latency
+      TRACE(TRACE_LEVEL_INFO, TRACE_BUTTON_CLICK, "CONFIRM/CANCEL");
       if (DISPLAY_MODE == DISPLAY_MODE_FREQUENCY_SETUP) {
         waterSensorsReadFrequencySelected = waterSensorsReadFrequencySelection;
-        int results = preferences.putInt(prefNameWaterSensorReadFrequency, waterSensorsReadFrequencySelected);
-        if (results == 0) {
-          Serial.println("Preferences: An error occured while saving Frequency settings");
-        } else {
-          Serial.println("Preferences: Frequency settings saved");
-        }
+        scheduleNextAnalysis();
+        saveSettings();
         DISPLAY_MODE = DISPLAY_MODE_OPERATIONS;
       }
       if (DISPLAY_MODE == DISPLAY_MODE_REBOOT) {
+        saveBeforeReboot();
         ESP.restart();
       }
       if (DISPLAY_MODE == DISPLAY_MODE_OPERATIONS) {
-          if (!handleSetOpsMode("auto")) {
-          Serial.println("Something went wrong. Valid values are on / off / auto");
-          }
+          handleSetOpsMode(MasterMode::Auto);
       }
       updateDisplay();
       break;
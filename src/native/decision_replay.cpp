@@ -0,0 +1,119 @@
+// PUMP DECISION REPLAY (env:native, program --decisions [--days N])
+// -----------------------------------------------------------------
+// Replays weeks of synthetic Klong measures through decidePump() (include/pump_decision.h)
+// with several policies, to tune the thresholds offline:
+//
+// - decisions/s : host throughput of decidePump() alone
+// - duty        : share of the time the pump runs
+// - starts      : pump starts (relay and motor wear)
+// - overheat    : overheat protection trips
+// - invalid     : decisions taken without a valid measure
+//
+// Klong model: 12.4h tide (+/-8cm), the pump draws the public klong down while
+// it runs and the inflow refills it when stopped. The sensor sends a measure every
+// second, with noise and 2% echo glitches, through the firmware filter chain.
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "hal.h"
+#include "sensor_filters.h"
+#include "pump_decision.h"
+
+typedef FilterChain<TopKBandFilter<30, 20, 30>> ReplaySensorFilter;   // PublicKlongSensorFilter (main.cpp)
+
+static const float DRAWDOWN_CM_PER_HOUR = 0.8;    // Distance added per hour of pumping
+static const float REFILL_CM_PER_HOUR = 2.0;      // Recovered per hour when stopped
+
+struct ReplayPolicy {
+  const char *name;
+  PumpPolicy policy;
+  uint32_t analysisSeconds;       // Decision frequency (frequencyOptions)
+};
+
+struct ReplayResult {
+  uint64_t decisions = 0, starts = 0, overheatTrips = 0, invalid = 0, runningSeconds = 0, seconds = 0;
+  double decisionsPerSecond = 0;
+};
+
+static double wallNow() {
+  using namespace std::chrono;
+  return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+static ReplayResult replay(const ReplayPolicy &replayPolicy, uint32_t days) {
+  static ReplaySensorFilter filter;
+  std::mt19937 rng(3);
+  std::normal_distribution<float> noise(0.0, 0.3);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  filter.reset();
+
+  ReplayResult result;
+  std::vector<PumpInputs> recorded;
+  PumpState state = PumpState::Off;
+  float drawdown = 0, distance = 0;
+  uint64_t startedAt = 0, cooldownAt = 0;
+  result.seconds = (uint64_t)days * 86400;
+  for (uint64_t t = 0; t < result.seconds; t++) {
+    float real = 28.0 + 8.0 * sin(2 * M_PI * t / (12.4 * 3600)) + drawdown;
+    float measure = real + noise(rng);
+    if (uniform(rng) < 0.02) measure *= 1.6;
+    if (!filter.process(measure, distance)) distance = 0.0;   // Still settling: no valid measure
+
+    if (t % replayPolicy.analysisSeconds == 0) {
+      PumpInputs inputs = { MasterMode::Auto, state, distance, (t - startedAt) / 60.0f, (t - cooldownAt) / 60.0f };
+      PumpDecision decision = decidePump(inputs, replayPolicy.policy);
+      if (decision.reason == PumpEvent::InvalidMeasure) result.invalid++;
+      if (decision.next == PumpState::Cooldown && state != PumpState::Cooldown) {
+        result.overheatTrips++;
+        cooldownAt = t;
+      }
+      if (decision.powered && !pumpPowered(state)) {
+        result.starts++;
+        startedAt = t;
+      }
+      state = decision.next;
+      result.decisions++;
+      recorded.push_back(inputs);
+    }
+
+    if (pumpPowered(state)) {
+      result.runningSeconds++;
+      drawdown += DRAWDOWN_CM_PER_HOUR / 3600;
+    } else {
+      drawdown = fmaxf(0, drawdown - REFILL_CM_PER_HOUR / 3600);
+    }
+  }
+
+  // Throughput of the decision alone, over the inputs seen during the replay
+  const size_t CALLS = 2000000;
+  volatile uint32_t sink = 0;
+  double start = wallNow();
+  for (size_t i = 0; i < CALLS; i++) sink = sink + (uint32_t)decidePump(recorded[i % recorded.size()], replayPolicy.policy).next;
+  result.decisionsPerSecond = CALLS / (wallNow() - start);
+  return result;
+}
+
+void runDecisionReplay(uint32_t days) {
+  // validMin, validMax, minimumWaterLevel, maxRuntime (min), cooldown (min)
+  static const ReplayPolicy policies[] = {
+    { "current (30cm, 6h/15min, 1 min)", { 5, 300, 30, 6 * 60, 15 }, 60 },
+    { "analysis every 5 min", { 5, 300, 30, 6 * 60, 15 }, 5 * 60 },
+    { "analysis every 30 min", { 5, 300, 30, 6 * 60, 15 }, 30 * 60 },
+    { "min level 28cm", { 5, 300, 28, 6 * 60, 15 }, 60 },
+    { "min level 33cm", { 5, 300, 33, 6 * 60, 15 }, 60 },
+    { "overheat 2h/15min", { 5, 300, 30, 2 * 60, 15 }, 60 },
+    { "overheat 2h/45min", { 5, 300, 30, 2 * 60, 45 }, 60 },
+  };
+
+  printf("Pump decision replay (%u days per policy)\n", days);
+  printf("  %-34s %12s %8s %8s %9s %8s\n", "Policy", "decisions/s", "duty", "starts", "overheat", "invalid");
+  double wallStart = wallNow();
+  for (const ReplayPolicy &policy : policies) {
+    ReplayResult r = replay(policy, days);
+    printf("  %-34s %12.3g %7.1f%% %8llu %9llu %8llu\n", policy.name, r.decisionsPerSecond, 100.0 * r.runningSeconds / r.seconds,
+           (unsigned long long)r.starts, (unsigned long long)r.overheatTrips, (unsigned long long)r.invalid);
+  }
+  printf("  %u simulated days replayed in %.1f s\n", days * (uint32_t)(sizeof(policies) / sizeof(policies[0])), wallNow() - wallStart);
+}
@@ -0,0 +1,112 @@
+// SENSOR FILTER REPLAY (env:native, program --filters)
+// ------------------------------------------------------
+// Replays synthetic Klong distance traces through several filter chains
+// (include/sensor_filters.h) to pick the cheapest one that is accurate enough:
+//
+// - cycles/sample : CPU cost on the host (TSC cycles on x86, nanoseconds otherwise)
+// - first output  : measures needed before the filter gives its first value
+// - RMS error     : on a slow tide with noise and 2% echo glitches, once settled
+// - glitches      : outputs more than 10% away from the real distance
+// - step settling : measures needed to follow a sudden 8cm change within 5% (for good)
+
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "hal.h"
+#include "sensor_filters.h"
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  static inline uint64_t cpuTicks() { return __rdtsc(); }
+  static const char *TICKS_UNIT = "cycles";
+#else
+  static inline uint64_t cpuTicks() { return std::chrono::steady_clock::now().time_since_epoch().count(); }
+  static const char *TICKS_UNIT = "ns";
+#endif
+
+struct Trace {
+  std::vector<float> truth;
+  std::vector<float> measured;
+};
+
+static Trace tideTrace(size_t samples) {
+  std::mt19937 rng(7);
+  std::normal_distribution<float> noise(0.0, 0.3);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  Trace t;
+  for (size_t i = 0; i < samples; i++) {
+    float real = 28.0 + 8.0 * sin(2 * M_PI * i / (12.4 * 3600));
+    float measure = real + noise(rng);
+    if (uniform(rng) < 0.02) measure *= 1.6;     // Ultrasonic echo glitch
+    t.truth.push_back(real);
+    t.measured.push_back(measure);
+  }
+  return t;
+}
+
+static Trace stepTrace(size_t before, size_t after) {
+  std::mt19937 rng(11);
+  std::normal_distribution<float> noise(0.0, 0.3);
+  Trace t;
+  for (size_t i = 0; i < before + after; i++) {
+    float real = i < before ? 30.0 : 22.0;
+    t.truth.push_back(real);
+    t.measured.push_back(real + noise(rng));
+  }
+  return t;
+}
+
+template <typename Filter>
+static void replay(const char *name) {
+  static Filter filter;   // Static: some configurations are too big for the stack
+
+  // Tide trace: cost, first output, accuracy
+  static const Trace tide = tideTrace(200000);
+  filter.reset();
+  std::vector<float> out(tide.measured.size(), NAN);
+  uint64_t start = cpuTicks();
+  for (size_t i = 0; i < tide.measured.size(); i++) {
+    filter.process(tide.measured[i], out[i]);
+  }
+  double ticksPerSample = (double)(cpuTicks() - start) / tide.measured.size();
+  size_t firstOutput = 0;
+  while (firstOutput < out.size() && std::isnan(out[firstOutput])) firstOutput++;
+  double squares = 0.0;
+  size_t glitches = 0;
+  for (size_t i = firstOutput; i < out.size(); i++) {
+    float err = out[i] - tide.truth[i];
+    squares += err * err;
+    if (fabsf(err) > 0.1f * tide.truth[i]) glitches++;
+  }
+  double rms = sqrt(squares / (out.size() - firstOutput));
+
+  // Step trace: how long until the output follows the new level (and stays there)
+  static const size_t STEP_AT = 500;
+  static const Trace step = stepTrace(STEP_AT, 2000);
+  filter.reset();
+  float value = NAN;
+  size_t lastOutOfTolerance = 0;
+  for (size_t i = 0; i < step.measured.size(); i++) {
+    bool valid = filter.process(step.measured[i], value);
+    if (i >= STEP_AT && (!valid || fabsf(value - step.truth[i]) > 0.05f * step.truth[i])) lastOutOfTolerance = i;
+  }
+  char settling[16];
+  if (lastOutOfTolerance >= step.measured.size() - 1) snprintf(settling, sizeof(settling), "never");
+  else snprintf(settling, sizeof(settling), "%zu", lastOutOfTolerance + 1 - STEP_AT);
+
+  printf("  %-40s %10.1f %12zu %10.3f %10zu %10s %8zu\n", name, ticksPerSample, firstOutput, rms, glitches, settling, sizeof(Filter));
+}
+
+void runFilterReplay() {
+  printf("Sensor filter replay\n");
+  printf("  %-40s %10s %12s %10s %10s %10s %8s\n", "Filter chain", TICKS_UNIT, "first output", "RMS (cm)", "glitches", "step", "bytes");
+  replay<FilterChain<TopKBandFilter<30, 20, 30>>>("TopKBand<30,20,3%> (current)");
+  replay<FilterChain<TopKBandFilter<300, 200, 30>>>("TopKBand<300,200,3%>");
+  replay<FilterChain<MedianFilter<5>>>("Median<5>");
+  replay<FilterChain<MedianFilter<9>>>("Median<9>");
+  replay<FilterChain<EmaFilter<20>>>("Ema<20%>");
+  replay<FilterChain<MedianFilter<5>, EmaFilter<20>>>("Median<5> > Ema<20%>");
+  replay<FilterChain<HampelFilter<15, 30>>>("Hampel<15,3.0>");
+  replay<FilterChain<HampelFilter<15, 30>, EmaFilter<30>>>("Hampel<15,3.0> > Ema<30%>");
+  replay<FilterChain<HampelFilter<15, 30>, MedianFilter<5>, EmaFilter<30>>>("Hampel<15,3.0> > Median<5> > Ema<30%>");
+}
@@ -0,0 +1,284 @@
+// Native (host) HAL: globals and the less trivial parts of the simulated APIs.
+// See include/hal_native.h
+
+#include "hal.h"
+
+namespace sim {
+  uint64_t nowUs = 0;
+  bool serialEcho = false;
+  uint64_t serialBytes = 0;
+  uint8_t pinLevels[40] = {0};
+  uint64_t gpioWrites = 0;
+  uint64_t rfFramesSent = 0;
+  unsigned long rfLastCodeSent = 0;
+  uint64_t nvsWrites = 0;
+  uint64_t flashWrites = 0;
+  uint64_t flashBytesWritten = 0;
+  uint64_t flashBytesRead = 0;
+  uint64_t flashErasedBytes = 0;
+  uint64_t flashBusyUs = 0;
+  uint64_t i2cBytes = 0;
+  uint64_t displayRefreshes = 0;
+  uint64_t wsMessages = 0;
+  uint64_t wsBytes = 0;
+  esp_now_recv_cb_t espNowRecvCb = nullptr;
+  bool restartRequested = false;
+  uint64_t idleRequestedUs = 0;
+  bool lightSleepRequested = false;
+  bool oledOn = true;
+  static void (*pinInterrupts[40])() = {};
+
+  static std::vector<unsigned long> rfReceived;
+  // Function-local: buttons register from global constructors in main.cpp, which can run before ours
+  static std::vector<ace_button::AceButton *> &buttons() {
+    static std::vector<ace_button::AceButton *> registered;
+    return registered;
+  }
+
+  struct BackgroundServiceConfig {
+    BackgroundService service;
+    uint32_t stackSize;
+    bool preemptsLoop;
+  };
+  static std::vector<BackgroundServiceConfig> backgroundServices;
+  uint64_t runBackgroundServices() {
+    uint64_t preemptedUs = 0;
+    for (auto &config : backgroundServices) {
+      if (!config.preemptsLoop) {
+        uint64_t flashBusy = flashBusyUs;
+        runInBackground(config.service);
+        preemptedUs += flashBusyUs - flashBusy;
+        continue;
+      }
+      uint64_t startUs = nowUs;
+      config.service();
+      preemptedUs += nowUs - startUs;
+    }
+    return preemptedUs;
+  }
+
+  void rfInject(unsigned long code) {
+    rfReceived.push_back(code);
+  }
+
+  void espNowDeliver(const void *data, int len) {
+    static const uint8_t mac[6] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x11};
+    if (espNowRecvCb) espNowRecvCb(mac, (const uint8_t *)data, len);
+  }
+
+  void clickButton(uint8_t pin) {
+    for (auto *b : buttons()) {
+      if (b->pin_ == pin) b->pendingClicks_++;
+    }
+    if (pinInterrupts[pin % 40]) pinInterrupts[pin % 40]();
+  }
+}
+
+bool startBackgroundService(const char *name, BackgroundService service, uint32_t idleMs,
+                            uint32_t stackSize, unsigned priority, int core) {
+  sim::backgroundServices.push_back({service, stackSize, core == sim::LOOP_CORE && priority > sim::LOOP_PRIORITY});
+  return true;
+}
+
+uint32_t backgroundServiceStackFree(BackgroundService service) {
+  for (auto &config : sim::backgroundServices) {
+    if (config.service == service) return config.stackSize;
+  }
+  return 0;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  sim::pinInterrupts[pin % 40] = isr;
+}
+
+HardwareSerial Serial;
+EspClass ESP;
+WiFiClass WiFi;
+TwoWire Wire;
+AsyncElegantOtaClass AsyncElegantOTA;
+
+// ---- NVS ----
+std::map<std::string, std::vector<uint8_t>> &Preferences::store() {
+  static std::map<std::string, std::vector<uint8_t>> nvs;
+  return nvs;
+}
+
+// ---- Flash file system ----
+SPIFFSFS SPIFFS;
+
+std::map<std::string, std::vector<uint8_t>> &SPIFFSFS::files() {
+  static std::map<std::string, std::vector<uint8_t>> files;
+  return files;
+}
+
+size_t SPIFFSFS::usedBytes() const {
+  size_t used = 0;
+  for (auto &file : files()) used += file.second.size();
+  return used;
+}
+
+bool SPIFFSFS::remove(const char *path) {
+  auto it = files().find(path);
+  if (it == files().end()) return false;
+  uint64_t sectors = (it->second.size() + 4095) / 4096;
+  sim::flashErasedBytes += sectors * 4096;
+  sim::flashBusyUs += sectors * sim::FLASH_US_PER_ERASE;
+  sim::advanceUs(sectors * sim::FLASH_US_PER_ERASE);
+  files().erase(it);
+  return true;
+}
+
+File SPIFFSFS::open(const char *path, const char *mode) {
+  auto it = files().find(path);
+  if (mode[0] == 'r') return it == files().end() ? File() : File(&it->second, mode);
+  std::vector<uint8_t> &data = files()[path];
+  if (mode[0] == 'w') data.clear();
+  return File(&data, mode);
+}
+
+size_t File::write(const uint8_t *buf, size_t len) {
+  if (!data_) return 0;
+  if (position_ + len > data_->size()) data_->resize(position_ + len);
+  memcpy(data_->data() + position_, buf, len);
+  position_ += len;
+  sim::flashWrites++;
+  sim::flashBytesWritten += len;
+  sim::flashBusyUs += sim::FLASH_US_PER_WRITE + len * sim::FLASH_US_PER_KB / 1024;
+  sim::advanceUs(sim::FLASH_US_PER_WRITE + len * sim::FLASH_US_PER_KB / 1024);
+  return len;
+}
+
+size_t File::read(uint8_t *buf, size_t len) {
+  if (!data_) return 0;
+  size_t n = std::min(len, data_->size() - position_);
+  memcpy(buf, data_->data() + position_, n);
+  position_ += n;
+  sim::flashBytesRead += n;
+  sim::advanceUs(sim::FLASH_US_PER_READ);
+  return n;
+}
+
+// ---- 433Mhz Radio ----
+bool RCSwitch::available() { return !sim::rfReceived.empty(); }
+unsigned long RCSwitch::getReceivedValue() { return sim::rfReceived.empty() ? 0 : sim::rfReceived.front(); }
+void RCSwitch::resetAvailable() {
+  if (!sim::rfReceived.empty()) sim::rfReceived.erase(sim::rfReceived.begin());
+}
+
+// ---- Buttons ----
+namespace ace_button {
+  ButtonConfig *ButtonConfig::getSystemButtonConfig() {
+    static ButtonConfig systemConfig;
+    return &systemConfig;
+  }
+
+  AceButton::AceButton(uint8_t pin, uint8_t defaultReleasedState, uint8_t id) : pin_(pin), id_(id) {
+    sim::buttons().push_back(this);
+  }
+
+  void AceButton::check() {
+    ButtonConfig::EventHandler handler = ButtonConfig::getSystemButtonConfig()->getEventHandler();
+    while (pendingClicks_ > 0) {
+      pendingClicks_--;
+      if (handler) handler(this, kEventClicked, HIGH);
+    }
+  }
+}
+
+// ---- Web Server ----
+AsyncWebServerRequest::AsyncWebServerRequest(const std::map<std::string, std::string> &params, const std::map<std::string, std::string> &headers) {
+  for (auto &p : params) params_.emplace_back(String(p.first), String(p.second));
+  for (auto &h : headers) headers_.emplace_back(String(h.first), String(h.second));
+}
+
+bool AsyncWebServerRequest::hasParam(const char *name) const {
+  for (auto &p : params_) if (p.name() == name) return true;
+  return false;
+}
+
+AsyncWebParameter *AsyncWebServerRequest::getParam(const char *name) {
+  for (auto &p : params_) if (p.name() == name) return &p;
+  return nullptr;
+}
+
+bool AsyncWebServerRequest::hasHeader(const char *name) const {
+  for (auto &h : headers_) if (h.name() == name) return true;
+  return false;
+}
+
+const String &AsyncWebServerRequest::header(const char *name) const {
+  static const String none;
+  for (auto &h : headers_) if (h.name() == name) return h.value();
+  return none;
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse *response) {
+  responseCode = response->code_;
+  responseBody = response->body_;
+  responseChunks = 0;
+  if (response->filler_) {
+    // Pulled as the real server does: whenever the connection can take a segment
+    uint8_t segment[sim::TCP_SEGMENT_BYTES];
+    for (;;) {
+      size_t n = response->filler_(segment, sizeof(segment), responseBody.size());
+      if (n == 0 || n == RESPONSE_TRY_AGAIN) break;
+      responseBody.append((const char *)segment, n);
+      responseChunks++;
+    }
+  }
+  responseHeaders.clear();
+  for (auto &h : response->headers_) responseHeaders[h.first] = h.second;
+  delete response;          // Like the real library, the request owns the response once sent
+}
+
+void AsyncWebServerRequest::send(int code, const char *contentType, const String &content) {
+  responseCode = code;
+  responseBody = content.c_str();
+}
+
+// Same template logic as the real library: %PLACEHOLDER% are replaced by the processor output
+void AsyncWebServerRequest::send_P(int code, const char *contentType, const char *content, AwsTemplateProcessor callback) {
+  responseCode = code;
+  responseBody.clear();
+  const char *p = content;
+  while (*p) {
+    const char *start = callback ? strchr(p, '%') : nullptr;
+    const char *end = start ? strchr(start + 1, '%') : nullptr;
+    if (!end) { responseBody += p; break; }
+    responseBody.append(p, start - p);
+    std::string name(start + 1, end - start - 1);
+    if (name.empty()) responseBody += '%';
+    else responseBody += callback(String(name)).c_str();
+    p = end + 1;
+  }
+}
+
+void AsyncWebServerRequest::redirect(const char *url) {
+  responseCode = 302;
+  responseBody = url;
+}
+
+bool AsyncWebServer::simulateGet(const char *uri, const std::map<std::string, std::string> &params, AsyncWebServerRequest **answered,
+                                 const std::map<std::string, std::string> &headers) {
+  auto route = routes_.find(uri);
+  if (route == routes_.end()) return false;
+  static AsyncWebServerRequest *lastRequest = nullptr;
+  delete lastRequest;
+  lastRequest = new AsyncWebServerRequest(params, headers);
+  route->second(lastRequest);
+  if (answered) *answered = lastRequest;
+  return true;
+}
+
+// ---- WebSocket ----
+void AsyncWebSocket::simulateConnect() {
+  clients_.emplace_back(nextId_++);
+  if (handler_) handler_(this, &clients_.back(), WS_EVT_CONNECT, nullptr, nullptr, 0);
+}
+
+void AsyncWebSocket::simulateDisconnect() {
+  if (clients_.empty()) return;
+  AsyncWebSocketClient client = clients_.front();
+  clients_.erase(clients_.begin());
+  if (handler_) handler_(this, &client, WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+}
@@ -0,0 +1,427 @@
+// HOST SIMULATOR (env:native)
+// ---------------------------
+// Runs the real setup()/loop() from main.cpp on the simulated HAL (include/hal_native.h)
+// with a synthetic Klong sensor sending ESP-NOW packets, then benchmarks
+// the main hot functions.
+//
+//   pio run -e native && .pio/build/native/program [--hours N] [--clients N] [--burst N] [--verbose]
+//   .pio/build/native/program --lowpower --clients 0   (30 min analysis, low power mode enabled)
+//   .pio/build/native/program --filters     (sensor filter replay, see filter_replay.cpp)
+//   .pio/build/native/program --decisions [--days N]   (pump decision replay, see decision_replay.cpp)
+//
+// Simulated time only advances by LOOP_COST_US per loop() plus whatever the
+// firmware blocks on (delay, radio, I2C, Serial, NVS), so a simulated day
+// runs in seconds and "stall" numbers show how long loop() was blocked.
+// Background services (FreeRTOS tasks on the ESP32) run between two loop()
+// and only stall it when they preempt it (its core, higher priority: 433Mhz frames)
+// or write / erase the flash (history). When loop() idles (idleWait, see cooperative_scheduler.h)
+// the clock jumps to the next deadline or simulated event, that time counts as idle
+// (or light sleep: ESP-NOW packets sent meanwhile are lost, buttons still wake it up).
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <new>
+#include "hal.h"
+#include "topk_average.h"
+#include "running_window.h"
+#include "rf_tx_queue.h"
+#include "oled_screen.h"
+#include "latency_histogram.h"
+#include "cooperative_scheduler.h"
+#include "history_store.h"
+#include "trace_log.h"
+#include "rf_commands.h"
+#include "pump_state_machine.h"
+
+// Firmware entry points and hot functions (main.cpp)
+void setup();
+void loop();
+void analyzeWaterLevels();
+void notifyClients();
+extern AsyncWebServer server;
+extern AsyncWebSocket ws;
+extern OledScreen oled;
+uint32_t getKlongPacketsDropped();
+extern RfTxQueue<8> rf433TxQueue;
+extern uint32_t telemetryFramesSent, telemetryFramesSuppressed;
+extern uint32_t statusSerializations, statusSerializationsSkipped;
+extern CooperativeScheduler<8> scheduler;
+extern HistoryStore history;
+extern TraceLog<64> traceLog;
+extern MasterMode masterMode;
+extern LearnedRemotes<256> rfLearned;
+const char *getCommandName(uint32_t code);
+// Other simulator modes
+void runFilterReplay();
+void runDecisionReplay(uint32_t days);
+
+// Mirror of the ESP-NOW packet sent by the Klong sensor device
+typedef struct klong_sensor_data_message {
+  short messageType;
+  char deviceId[16];
+  char version[5];
+  unsigned long millis;
+  float waterDistance;
+} klong_sensor_data_message;
+
+const uint32_t LOOP_COST_US = 100;             // Modeled cost of an idle loop() pass on the ESP32
+const uint32_t SENSOR_PERIOD_MS = 1000;        // Klong sensor sends one measure per second
+const uint8_t MENU_BUTTON_PIN = 26;            // BUTTON_MENU_PIN (main.cpp)
+// Rough current draw (ESP32 / SSD1306 datasheet orders of magnitude): only meant to
+// compare builds and modes, not to size a battery
+const double AWAKE_MA = 100.0;                 // WiFi softAP + ESP-NOW listening, CPU idle
+const double CPU_BUSY_EXTRA_MA = 20.0;         // loop() core running on top of that
+const double LIGHT_SLEEP_MA = 0.8;             // Radio off, RAM retained
+const double OLED_ON_MA = 10.0;                // SSD1306 showing a status screen
+
+static std::mt19937 rng(42);
+volatile float benchSink;                      // Keeps benchmarked results alive
+
+// Synthetic Klong water distance: slow tide + sensor noise + some outliers
+float syntheticWaterDistance(double seconds) {
+  static std::normal_distribution<float> noise(0.0, 0.3);
+  static std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  float distance = 28.0 + 8.0 * sin(2 * M_PI * seconds / (12.4 * 3600));
+  distance += noise(rng);
+  if (uniform(rng) < 0.02) distance *= 1.6;     // Ultrasonic echo glitch
+  return distance;
+}
+
+// Heap allocations counter: benchmarks report the allocations done per call
+static uint64_t heapAllocations = 0, heapAllocatedBytes = 0;
+void *operator new(size_t size) {
+  heapAllocations++;
+  heapAllocatedBytes += size;
+  void *p = malloc(size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+// noinline: once inlined, GCC sees free() on an operator new pointer and warns (-Wmismatched-new-delete)
+__attribute__((noinline)) void operator delete(void *p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept { free(p); }
+
+double wallSeconds() {
+  using namespace std::chrono;
+  return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename F> double benchNsPerCall(const char *name, long iterations, F fn) {
+  uint64_t allocations = heapAllocations, allocatedBytes = heapAllocatedBytes;
+  double start = wallSeconds();
+  for (long i = 0; i < iterations; i++) fn(i);
+  double ns = (wallSeconds() - start) * 1e9 / iterations;
+  printf("  %-32s %10.1f ns/call %8.1f allocs/call %8.1f bytes allocated/call\n", name, ns,
+         (double)(heapAllocations - allocations) / iterations, (double)(heapAllocatedBytes - allocatedBytes) / iterations);
+  return ns;
+}
+
+// Seeding cost of the top-K average for a given window size (window refilled on each call)
+template <size_t N, size_t K> void benchTopKAverage(const char *name) {
+  static float source[N], window[N];
+  for (size_t i = 0; i < N; i++) source[i] = syntheticWaterDistance(i);
+  benchNsPerCall(name, 2000000 / N, [](long) {
+    memcpy(window, source, sizeof(window));
+    TopKAverage<N, K>::apply(window);
+  });
+}
+
+// Per-sample cost of the running window (push + mean + variance), should stay flat whatever N
+template <size_t N> void benchRunningWindow(const char *name) {
+  static RunningWindow<N> window;
+  benchNsPerCall(name, 4000000, [](long i) {
+    window.push(20.0 + (i % 97) * 0.1);
+    benchSink = window.mean() + window.variance();
+  });
+}
+
+// Lets the firmware run (no sensor, no clicks) for the given simulated time
+void runIdleFor(uint64_t us) {
+  uint64_t endUs = sim::nowUs + us;
+  while (sim::nowUs < endUs) {
+    loop();
+    sim::advanceUs(LOOP_COST_US);
+    sim::runBackgroundServices();
+    if (sim::idleRequestedUs > 0) sim::nowUs = std::min(sim::nowUs + sim::idleRequestedUs, endUs);
+    sim::idleRequestedUs = 0;
+    sim::lightSleepRequested = false;
+  }
+}
+
+void printLatency(const char *name, const LatencyHistogram &latency) {
+  printf("  %-24s %10u samples, mean %.1f ms, p50 <= %.0f ms, p95 <= %.0f ms, p99 <= %.0f ms, max %.1f ms\n", name,
+         latency.count(), latency.meanUs() / 1000.0, latency.percentileUs(50) / 1000.0, latency.percentileUs(95) / 1000.0,
+         latency.percentileUs(99) / 1000.0, latency.maxUs() / 1000.0);
+}
+
+int main(int argc, char **argv) {
+  double hours = 24;
+  int clients = 1;
+  int burst = 1;
+  double clickEvery = 0;
+  bool lowPower = false;
+  bool decisions = false;
+  int days = 28;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--hours") && i + 1 < argc) hours = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--clients") && i + 1 < argc) clients = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--burst") && i + 1 < argc) burst = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--clicks") && i + 1 < argc) clickEvery = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--lowpower")) lowPower = true;
+    else if (!strcmp(argv[i], "--verbose")) sim::serialEcho = true;
+    else if (!strcmp(argv[i], "--filters")) { runFilterReplay(); return 0; }
+    else if (!strcmp(argv[i], "--decisions")) decisions = true;
+    else if (!strcmp(argv[i], "--days") && i + 1 < argc) days = atoi(argv[++i]);
+    else {
+      printf("Usage: %s [--hours N] [--clients N] [--burst N] [--clicks SECONDS] [--lowpower] [--verbose] | --filters | --decisions [--days N]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (decisions) {
+    runDecisionReplay(days);
+    return 0;
+  }
+
+  setup();
+  if (lowPower) {
+    server.simulateGet("/frequency", {{"freq", "10"}});     // 30 min
+    server.simulateGet("/powermode", {{"mode", "low"}});
+  }
+  for (int i = 0; i < clients; i++) ws.simulateConnect();
+
+  // SIMULATION
+  // ----------
+  klong_sensor_data_message packet = {};
+  strcpy(packet.deviceId, "BKO-PK-SENSOR");
+  strcpy(packet.version, "v1.2");
+  uint64_t endUs = sim::nowUs + (uint64_t)(hours * 3600e6);
+  uint64_t nextPacketUs = sim::nowUs;
+  uint64_t nextClickUs = sim::nowUs + clickEvery * 1e6;
+  std::uniform_int_distribution<int> clickJitter(0, 999999);
+  LatencyHistogram clickLag;              // Click -> button handled (loop() responsiveness)
+  uint64_t loops = 0, packets = 0, worstStallUs = 0, stallsOver50ms = 0;
+  uint64_t idleUs = 0, sleepUs = 0, oledOnUs = 0, packetsMissedAsleep = 0;
+  double wallStart = wallSeconds();
+  uint64_t simStart = sim::nowUs;
+  while (sim::nowUs < endUs) {
+    if (sim::nowUs >= nextPacketUs) {
+      // --burst N: the sensor sends N packets at once (load test of the receive queue)
+      for (int b = 0; b < burst; b++) {
+        packet.millis = millis();
+        packet.waterDistance = syntheticWaterDistance(sim::nowUs / 1e6);
+        sim::espNowDeliver(&packet, sizeof(packet));
+        packets++;
+      }
+      nextPacketUs += SENSOR_PERIOD_MS * 1000 * burst;
+    }
+    // --clicks N: someone presses MENU every N seconds (at a random moment, possibly
+    // while loop() is busy: it is only seen when the current loop() returns)
+    if (clickEvery > 0 && sim::nowUs >= nextClickUs) {
+      clickLag.record(sim::nowUs - nextClickUs);
+      sim::clickButton(MENU_BUTTON_PIN);
+      nextClickUs += clickEvery * 1e6 + clickJitter(rng);
+    }
+    uint64_t before = sim::nowUs;
+    bool oledOn = sim::oledOn;
+    loop();
+    uint64_t stall = sim::nowUs - before;
+    sim::advanceUs(LOOP_COST_US);
+    stall = std::max(stall, sim::runBackgroundServices());   // A frame on air, a flash erase: loop() can't run either
+    if (stall > worstStallUs) worstStallUs = stall;
+    if (stall > 50000) stallsOver50ms++;
+    loops++;
+    // loop() asked to idle: nothing happens until its next deadline or the next simulated event
+    if (sim::idleRequestedUs > 0) {
+      uint64_t wakeUs = sim::nowUs + std::min(sim::idleRequestedUs, endUs - sim::nowUs);
+      if (!sim::lightSleepRequested) wakeUs = std::min(wakeUs, nextPacketUs);
+      if (clickEvery > 0) wakeUs = std::min(wakeUs, nextClickUs);
+      if (wakeUs > sim::nowUs) {
+        (sim::lightSleepRequested ? sleepUs : idleUs) += wakeUs - sim::nowUs;
+        sim::nowUs = wakeUs;
+      }
+      // Radio off while asleep: the sensor packets sent meanwhile are lost
+      while (sim::lightSleepRequested && nextPacketUs < sim::nowUs) {
+        nextPacketUs += SENSOR_PERIOD_MS * 1000 * burst;
+        packetsMissedAsleep += burst;
+      }
+      sim::idleRequestedUs = 0;
+      sim::lightSleepRequested = false;
+    }
+    if (oledOn) oledOnUs += sim::nowUs - before;
+  }
+  double wall = wallSeconds() - wallStart;
+  double simulated = (sim::nowUs - simStart) / 1e6;
+
+  printf("Simulation\n");
+  printf("  simulated time           %10.0f s (%.1f h)\n", simulated, simulated / 3600);
+  printf("  wall time                %10.3f s  (x%.0f real time)\n", wall, simulated / wall);
+  printf("  loop() iterations        %10llu\n", (unsigned long long)loops);
+  printf("  ESP-NOW packets          %10llu (%u dropped)\n", (unsigned long long)packets, getKlongPacketsDropped());
+  printf("  worst loop() stall       %10.1f ms\n", worstStallUs / 1000.0);
+  printf("  loop() stalls > 50ms     %10llu\n", (unsigned long long)stallsOver50ms);
+  double sleepShare = sleepUs / 1e6 / simulated;
+  double busyShare = 1.0 - (idleUs + sleepUs) / 1e6 / simulated;
+  double oledShare = oledOnUs / 1e6 / simulated;
+  double averageMa = (1 - sleepShare) * AWAKE_MA + busyShare * CPU_BUSY_EXTRA_MA + sleepShare * LIGHT_SLEEP_MA + oledShare * OLED_ON_MA;
+  printf("  CPU busy (loop core)     %10.2f %%\n", busyShare * 100);
+  printf("  Light sleep              %10.2f %% (%llu ESP-NOW packets missed while asleep)\n", sleepShare * 100,
+         (unsigned long long)packetsMissedAsleep);
+  printf("  OLED on                  %10.2f %%\n", oledShare * 100);
+  printf("  Estimated current        %10.1f mA average, %.0f mAh/day\n", averageMa, averageMa * 24);
+  printf("  433Mhz frames sent       %10llu (%u deduplicated, %u dropped)\n", (unsigned long long)sim::rfFramesSent,
+         rf433TxQueue.deduplicated(), rf433TxQueue.dropped());
+  printf("  Telemetry frames         %10u sent / %u suppressed\n", telemetryFramesSent, telemetryFramesSuppressed);
+  printf("  I2C bytes to display     %10llu (%u refreshes, %.1f bytes/refresh, %u frames coalesced)\n", (unsigned long long)sim::i2cBytes,
+         oled.flushes(), oled.flushes() ? (double)sim::i2cBytes / oled.flushes() : 0.0, oled.framesCoalesced());
+  printf("  Serial bytes             %10llu (trace: %u records dropped)\n", (unsigned long long)sim::serialBytes, traceLog.dropped());
+  printf("  WebSocket messages/bytes %10llu / %llu\n", (unsigned long long)sim::wsMessages, (unsigned long long)sim::wsBytes);
+  printf("  Status JSON built        %10u (%u skipped, no client)\n", statusSerializations, statusSerializationsSkipped);
+  if (clickEvery > 0) {
+    printLatency("Click -> button handled", clickLag);
+    printLatency("Button handled -> screen", oled.inputLatency());
+  }
+  printf("  NVS writes               %10llu\n", (unsigned long long)sim::nvsWrites);
+  printf("  History records          %10u minutes, %u hours, %u days (%u pages written, %u dropped)\n",
+         history.recordsAdded(HISTORY_MINUTES), history.recordsAdded(HISTORY_HOURS), history.recordsAdded(HISTORY_DAYS),
+         history.pagesWritten(), history.pagesDropped());
+  {
+    // Read the minutes back (what the web server would do): all there, in time order
+    HistoryStore::Cursor cursor = history.seek(HISTORY_MINUTES, 0);
+    HistoryRecord records[32];
+    uint32_t readBack = 0, outOfOrder = 0, previous = 0;
+    for (size_t n; (n = history.read(cursor, records, 32)) > 0;) {
+      for (size_t i = 0; i < n; i++, readBack++) {
+        if (readBack > 0 && records[i].time <= previous) outOfOrder++;
+        previous = records[i].time;
+      }
+    }
+    printf("  History read back        %10u minutes (%u out of order), capacity %u minutes at least\n", readBack, outOfOrder,
+           history.capacity(HISTORY_MINUTES));
+  }
+  printf("  Flash (SPIFFS)           %10llu writes, %llu bytes (%.1f KB/day), %llu bytes erased, %zu bytes used\n",
+         (unsigned long long)sim::flashWrites, (unsigned long long)sim::flashBytesWritten,
+         sim::flashBytesWritten / 1024.0 / (simulated / 86400), (unsigned long long)sim::flashErasedBytes, SPIFFS.usedBytes());
+  printf("Scheduler tasks (%u idle waits)\n", scheduler.idleCalls());
+  for (size_t i = 0; i < scheduler.count(); i++) {
+    printf("  %-24s %10u runs, %8.1f us busy/run\n", scheduler.name(i), scheduler.runs(i),
+           scheduler.runs(i) ? (double)scheduler.busyUs(i) / scheduler.runs(i) : 0.0);
+  }
+
+  // MICRO BENCHMARKS (host CPU time, blocking hardware costs are simulated only)
+  // ----------------
+  printf("Benchmarks\n");
+  benchNsPerCall("analyzeWaterLevels()", 100000, [](long) { analyzeWaterLevels(); });
+  benchNsPerCall("notifyClients()", 100000, [](long) { notifyClients(); });
+  printf("  %-32s %10zu bytes\n", "notifyClients() payload", ws.lastMessage.size());
+  AsyncWebServerRequest *page = nullptr;
+  benchNsPerCall("GET /", 2000, [&](long) { server.simulateGet("/", {}, &page); });
+  printf("  %-32s %10zu bytes\n", "GET / payload", page ? page->responseBody.size() : 0);
+  std::map<std::string, std::string> revalidate = {{"If-None-Match", page ? page->responseHeaders["ETag"] : ""}};
+  benchNsPerCall("GET / (cached, ETag)", 2000, [&](long) { server.simulateGet("/", {}, &page, revalidate); });
+  printf("  %-32s %10d\n", "GET / (cached) status", page ? page->responseCode : 0);
+  // Someone clicking around: 10 /setmin then 3 /frequency requests, 100ms apart
+  uint64_t nvsWrites = sim::nvsWrites, handlersUs = 0;
+  for (int i = 0; i < 13; i++) {
+    uint64_t startUs = sim::nowUs;
+    if (i < 10) server.simulateGet("/setmin", {{"lvl", std::to_string(25 + i)}});
+    else server.simulateGet("/frequency", {{"freq", std::to_string(i - 8)}});
+    handlersUs += sim::nowUs - startUs;
+    runIdleFor(100000);
+  }
+  runIdleFor(5000000);
+  printf("  %-32s %10.1f ms/request (simulated) %llu NVS writes\n", "Settings burst (13 requests)", handlersUs / 13 / 1000.0,
+         (unsigned long long)(sim::nvsWrites - nvsWrites));
+  // History charts: chunked CSV, LTTB downsampled (the page asks for its canvas width, a few records per
+  // point over 24h). Every point sent once, in time order
+  static const struct { const char *name; long seconds; int points; } charts[] = {
+    { "GET /history (3h, 100 pts)", 3 * 3600, 100 }, { "GET /history (3h, 500 pts)", 3 * 3600, 500 },
+    { "GET /history (24h)", 86400, 500 }, { "GET /history (7 days)", 7 * 86400, 500 }, { "GET /history (30 days)", 30 * 86400, 500 },
+  };
+  for (auto &chart : charts) {
+    uint64_t startUs = sim::nowUs, flashRead = sim::flashBytesRead;
+    double startWall = wallSeconds();
+    page = nullptr;
+    server.simulateGet("/history", {{"from", std::to_string(-chart.seconds)}, {"points", std::to_string(chart.points)}}, &page);
+    double hostMs = (wallSeconds() - startWall) * 1000;
+    const char *tier = page ? strstr(page->responseBody.c_str(), "tier=") : nullptr;
+    size_t lines = 0, outOfOrder = 0;
+    if (page) {
+      const std::string &text = page->responseBody;
+      unsigned long previous = 0;
+      for (size_t start = 0, end; (end = text.find('\n', start)) != std::string::npos; start = end + 1) {
+        if (!isdigit((unsigned char)text[start])) continue;   // "# now=..." and the column names
+        unsigned long time = strtoul(text.c_str() + start, nullptr, 10);
+        if (lines++ > 0 && time <= previous) outOfOrder++;
+        previous = time;
+      }
+    }
+    printf("  %-32s %10.1f ms (flash, simulated) + %.1f ms host, %zu bytes in %zu chunks, %zu points (%zu out of order), %llu bytes read, %.*s\n",
+           chart.name, (sim::nowUs - startUs) / 1000.0, hostMs, page ? page->responseBody.size() : 0, page ? page->responseChunks : 0,
+           lines, outOfOrder, (unsigned long long)(sim::flashBytesRead - flashRead), tier ? (int)strcspn(tier, " ") : 0, tier ? tier : "");
+  }
+  // Prometheus scrape (metrics of the whole run, benchmarks above included; buckets left out here)
+  page = nullptr;
+  benchNsPerCall("GET /metrics", 2000, [&](long) { server.simulateGet("/metrics", {}, &page); });
+  if (page && page->responseCode == 200) {
+    printf("  %-32s %10zu bytes in %zu chunks\n", "GET /metrics payload", page->responseBody.size(), page->responseChunks);
+    const std::string &text = page->responseBody;
+    for (size_t start = 0, end; (end = text.find('\n', start)) != std::string::npos; start = end + 1) {
+      std::string line = text.substr(start, end - start);
+      if (line[0] != '#' && line.find("_bucket") == std::string::npos) printf("    %s\n", line.c_str());
+    }
+  }
+  // 433Mhz remotes: RM2 A ON / OFF force the pumps, then a learned code puts them back to auto
+  {
+    const uint32_t RM2_A_ON = 4195665, RM2_A_OFF = 4195668, LEARNED = 1234567, TELEMETRY = 271012478;
+    MasterMode before = masterMode;
+    sim::rfInject(RM2_A_ON);
+    runIdleFor(2000000);
+    MasterMode afterOn = masterMode;
+    sim::rfInject(RM2_A_OFF);
+    runIdleFor(2000000);
+    MasterMode afterOff = masterMode;
+    server.simulateGet("/learn", {{"action", "auto"}});
+    sim::rfInject(TELEMETRY);               // Our own telemetry on air meanwhile: not learned
+    runIdleFor(2000000);
+    sim::rfInject(LEARNED);                 // Learned...
+    runIdleFor(2000000);
+    sim::rfInject(LEARNED);                 // ...then dispatched
+    runIdleFor(2000000);
+    printf("  %-32s %s -> A-ON %s -> A-OFF %s -> learned code %s (telemetry %s)\n", "433Mhz remote (master mode)", masterModeName(before),
+           masterModeName(afterOn), masterModeName(afterOff), masterModeName(masterMode), rfLearned.find(TELEMETRY) ? "LEARNED" : "ignored");
+    server.simulateGet("/learn", {{"action", "clear"}});
+    runIdleFor(1000000);
+  }
+  // Received code -> command: built-in remotes (perfect hash), learned codes (hash table, a few hundred)
+  static const uint32_t remoteCodes[] = { 4195665, 4195668, 4199700, 5592340, 5588305, 271012478, 111000000, 42 };
+  benchNsPerCall("getCommandName() (built-in)", 4000000, [](long i) { benchSink = getCommandName(remoteCodes[i & 7])[0]; });
+  {
+    static LearnedRemotes<512> learned;
+    static std::vector<uint32_t> codes;
+    Preferences benchPreferences;
+    benchPreferences.begin("bench");
+    std::uniform_int_distribution<uint32_t> anyCode(1, 16777215);   // 24 bit codes
+    while (codes.size() < 300) {
+      uint32_t code = anyCode(rng);
+      if (!learned.find(code) && learned.learn(code, RfAction::PumpsOff, benchPreferences, "learned")) codes.push_back(code);
+    }
+    benchPreferences.remove("learned");
+    benchNsPerCall("LearnedRemotes<512> hit (300)", 4000000, [](long i) { benchSink = learned.find(codes[i % 300]) != nullptr; });
+    benchNsPerCall("LearnedRemotes<512> miss (300)", 4000000, [](long i) { benchSink = learned.find(codes[i % 300] ^ 0x1000000) != nullptr; });
+    benchNsPerCall("linear scan hit (300)", 400000, [](long i) {
+      uint32_t code = codes[(i * 7) % 300];
+      size_t k = 0;
+      while (k < codes.size() && codes[k] != code) k++;
+      benchSink = k;
+    });
+  }
+  benchTopKAverage<30, 20>("TopKAverage<30, 20>");
+  benchTopKAverage<300, 200>("TopKAverage<300, 200>");
+  benchTopKAverage<1000, 666>("TopKAverage<1000, 666>");
+  benchRunningWindow<30>("RunningWindow<30>");
+  benchRunningWindow<256>("RunningWindow<256>");
+  benchRunningWindow<1024>("RunningWindow<1024>");
+  benchRunningWindow<4096>("RunningWindow<4096>");
+  benchNsPerCall("loop()", 1000000, [](long) { loop(); sim::advanceUs(LOOP_COST_US); });
+  return 0;
+}
@@ -0,0 +1,58 @@
+# Turns the static dashboard (web/index.html) into include/dashboard_html.h:
+# a gzip compressed byte array served as is by the "/" route, plus its ETag.
+#
+# Runs before every build (extra_scripts in platformio.ini) and only rewrites
+# the header when the page changed. Can also be run by hand:
+#   python3 tools/embed_web.py
+
+import gzip
+import hashlib
+import os
+
+try:
+    Import("env")  # Run by PlatformIO (SCons), __file__ is not defined there
+    ROOT = env.subst("$PROJECT_DIR")
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "web", "index.html")
+TARGET = os.path.join(ROOT, "include", "dashboard_html.h")
+
+
+def render(page):
+    # mtime=0 so the same page always gives the same bytes (and the same ETag)
+    compressed = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(compressed).hexdigest()[:16]
+    lines = [
+        "#pragma once",
+        "",
+        "// GENERATED by tools/embed_web.py from web/index.html, do not edit.",
+        "// %d bytes of HTML, %d bytes gzip compressed." % (len(page), len(compressed)),
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        '#include "hal.h"',
+        "",
+        '#define DASHBOARD_HTML_ETAG "\\"%s\\""' % etag,
+        "",
+        "const size_t dashboard_html_gz_len = %d;" % len(compressed),
+        "const uint8_t dashboard_html_gz[] PROGMEM = {",
+    ]
+    for i in range(0, len(compressed), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in compressed[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def embed():
+    with open(SOURCE, "rb") as f:
+        header = render(f.read())
+    if os.path.exists(TARGET):
+        with open(TARGET) as f:
+            if f.read() == header:
+                return
+    with open(TARGET, "w") as f:
+        f.write(header)
+    print("embed_web: %s updated" % os.path.relpath(TARGET, ROOT))
+
+
+embed()